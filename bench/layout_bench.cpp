@@ -0,0 +1,206 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <map>
+#include <random>
+#include <cmath>
+#include <type_traits>
+
+#include "wgen.h"
+#include "chunk.h"
+#include "cmesher.h"
+
+using namespace world_types;
+
+//generation, meshing and raycast throughput for the block order the mesher was built with
+//build it once with Y_MORTON_LAYOUT off and once with it on to compare the layouts
+
+namespace
+{
+	constexpr int passes = 5;
+	constexpr int radius = 3;
+
+	constexpr ytype::direction sides[] = {ytype::direction::left, ytype::direction::right, ytype::direction::forward,
+		ytype::direction::back, ytype::direction::down, ytype::direction::up};
+
+	typedef std::map<vec3d<int>, world_chunk> chunk_map;
+
+	template<typename F>
+	double time_us(F func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		for(int pass = 0; pass < passes; ++pass)
+			func();
+
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now()-start).count()/passes;
+	}
+
+	void generate(world_generator& generator, chunk_map& chunks)
+	{
+		for(int x = -radius; x <= radius; ++x)
+		{
+			for(int y = -1; y <= 3; ++y)
+			{
+				for(int z = -radius; z <= radius; ++z)
+					generator.chunk_gen(chunks[{x, y, z}], {x, y, z});
+			}
+		}
+	}
+
+	size_t mesh(const chunk_map& chunks, chunk_mesh& c_mesh)
+	{
+		size_t vertices = 0;
+
+		for(const auto& [pos, chunk] : chunks)
+		{
+			if(chunk.empty() || chunk.check_empty())
+				continue;
+
+			padded_chunk padded(chunk);
+
+			for(const auto side : sides)
+			{
+				const auto neighbour = chunks.find(pos+ytype::direction_offset(side));
+
+				if(neighbour!=chunks.end())
+					padded.set_neighbour(side, neighbour->second);
+			}
+
+			chunk_mesher(padded, c_mesh).build();
+
+			vertices += c_mesh.transparent.size();
+			for(const auto& c_vertices : c_mesh.opaque)
+				vertices += c_vertices.size();
+		}
+
+		return vertices;
+	}
+
+	struct ray
+	{
+		vec3d<float> start;
+		vec3d<float> direction;
+	};
+
+	std::vector<ray> create_rays(const int amount)
+	{
+		std::mt19937 gen(7);
+		std::uniform_real_distribution<float> start_distrib(-radius*chunk_size, (radius+1)*chunk_size);
+		std::uniform_real_distribution<float> height_distrib(chunk_size, 3*chunk_size);
+		std::uniform_real_distribution<float> direction_distrib(-1, 1);
+
+		std::vector<ray> rays;
+		rays.reserve(amount);
+
+		for(int i = 0; i < amount; ++i)
+		{
+			//aimed downwards so most of them hit the terrain
+			const vec3d<float> direction{direction_distrib(gen), -1, direction_distrib(gen)};
+
+			rays.push_back({{start_distrib(gen), height_distrib(gen), start_distrib(gen)}, direction.normalize()});
+		}
+
+		return rays;
+	}
+
+	//steps block by block like the physics raycaster, solid checks go through the columns
+	//the block that got hit is read through the layout
+	int raycast(const chunk_map& chunks, const ray c_ray, const int length)
+	{
+		vec3d<int> block_pos{static_cast<int>(std::floor(c_ray.start.x)),
+			static_cast<int>(std::floor(c_ray.start.y)),
+			static_cast<int>(std::floor(c_ray.start.z))};
+
+		const vec3d<int> step{c_ray.direction.x<0 ? -1 : 1, c_ray.direction.y<0 ? -1 : 1, c_ray.direction.z<0 ? -1 : 1};
+
+		const auto axis_delta = [](const float direction)
+		{
+			return direction==0 ? INFINITY : std::abs(1/direction);
+		};
+
+		const auto axis_next = [](const float start, const int block, const int step, const float delta)
+		{
+			const float wall = step>0 ? block+1-start : start-block;
+			return wall*delta;
+		};
+
+		const vec3d<float> delta{axis_delta(c_ray.direction.x), axis_delta(c_ray.direction.y), axis_delta(c_ray.direction.z)};
+		vec3d<float> next{axis_next(c_ray.start.x, block_pos.x, step.x, delta.x),
+			axis_next(c_ray.start.y, block_pos.y, step.y, delta.y),
+			axis_next(c_ray.start.z, block_pos.z, step.z, delta.z)};
+
+		const world_chunk* c_chunk = nullptr;
+		vec3d<int> c_chunk_pos{0, 0, 0};
+
+		for(int i = 0; i < length; ++i)
+		{
+			const vec3d<int> local = world_chunk::closest_bound_block(block_pos);
+			const vec3d<int> chunk_pos = (block_pos-local)/chunk_size;
+
+			if(c_chunk==nullptr || chunk_pos!=c_chunk_pos)
+			{
+				const auto found = chunks.find(chunk_pos);
+				if(found==chunks.end())
+					return 0;
+
+				c_chunk = &found->second;
+				c_chunk_pos = chunk_pos;
+			}
+
+			if(!c_chunk->empty() && c_chunk->solid(local))
+				return c_chunk->block(local).type();
+
+			if(next.x<=next.y && next.x<=next.z)
+			{
+				block_pos.x += step.x;
+				next.x += delta.x;
+			} else if(next.y<=next.z)
+			{
+				block_pos.y += step.y;
+				next.y += delta.y;
+			} else
+			{
+				block_pos.z += step.z;
+				next.z += delta.z;
+			}
+		}
+
+		return 0;
+	}
+};
+
+int main()
+{
+	world_generator generator;
+	generator.seed(7);
+
+	chunk_map chunks;
+	generate(generator, chunks);
+
+	const double amount = chunks.size();
+
+	const std::vector<ray> rays = create_rays(100000);
+
+	chunk_mesh c_mesh;
+
+	size_t vertices = 0;
+	size_t hits = 0;
+
+	const double generation_us = time_us([&](){generate(generator, chunks);})/amount;
+	const double mesh_us = time_us([&](){vertices = mesh(chunks, c_mesh);})/amount;
+	const double ray_us = time_us([&]()
+	{
+		hits = 0;
+		for(const auto& c_ray : rays)
+			hits += raycast(chunks, c_ray, 128)!=0;
+	})/rays.size();
+
+	std::cout << "layout: " << (std::is_same_v<chunk_layout::current, chunk_layout::morton> ? "morton" : "linear") << std::endl;
+	std::cout << "chunks: " << chunks.size() << ", mesh vertices: " << vertices << ", ray hits: " << hits << std::endl;
+	std::cout << "generation: " << generation_us << " us per chunk" << std::endl;
+	std::cout << "meshing: " << mesh_us << " us per chunk" << std::endl;
+	std::cout << "raycasts: " << ray_us << " us per ray" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,307 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include "wgen.h"
+#include "chunk.h"
+#include "cmesher.h"
+
+using namespace world_types;
+
+//compares the column mask mesher against meshing block by block with neighbour checks
+//both run over the same generated terrain chunks and have to agree on the visible face area
+//the block by block mesher also runs with the per call property switches the registry replaced
+
+namespace
+{
+	constexpr int passes = 20;
+
+	constexpr ytype::direction sides[] = {ytype::direction::left, ytype::direction::right, ytype::direction::forward,
+		ytype::direction::back, ytype::direction::down, ytype::direction::up};
+
+	struct bench_chunks
+	{
+		std::vector<padded_chunk> padded;
+		//every block of the padded chunks in a row, for timing the property lookups alone
+		std::vector<world_block> blocks;
+	};
+
+	bench_chunks generate_chunks(const int radius)
+	{
+		world_generator generator;
+		generator.seed(7);
+
+		std::map<vec3d<int>, world_chunk> chunks;
+		for(int x = -radius; x <= radius; ++x)
+		{
+			for(int y = -1; y <= 3; ++y)
+			{
+				for(int z = -radius; z <= radius; ++z)
+					generator.chunk_gen(chunks[{x, y, z}], {x, y, z});
+			}
+		}
+
+		bench_chunks out;
+		for(const auto& [pos, chunk] : chunks)
+		{
+			if(chunk.empty() || chunk.check_empty())
+				continue;
+
+			padded_chunk c_padded(chunk);
+
+			for(const auto side : sides)
+			{
+				const auto neighbour = chunks.find(pos+ytype::direction_offset(side));
+
+				if(neighbour!=chunks.end())
+					c_padded.set_neighbour(side, neighbour->second);
+			}
+
+			out.padded.push_back(c_padded);
+
+			for(int x = 0; x < chunk_size; ++x)
+			{
+				for(int y = 0; y < chunk_size; ++y)
+				{
+					for(int z = 0; z < chunk_size; ++z)
+						out.blocks.push_back(c_padded.block({x, y, z}));
+				}
+			}
+		}
+
+		return out;
+	}
+
+	//block properties from the registry, one indexed load
+	struct registry_properties
+	{
+		static const texture_face& texture(const world_block block) noexcept
+		{
+			return block.texture();
+		}
+
+		static bool transparent(const world_block block) noexcept
+		{
+			return block.transparent();
+		}
+	};
+
+	//block properties built by a switch on every call, the way world_block did it before the registry
+	//they used to live in wblock.cpp, so they arent inlined here either
+	struct switch_properties
+	{
+		[[gnu::noinline]] static texture_face texture(const world_block block) noexcept
+		{
+			return block_registry::block_texture(block.type(), block.info().grassy);
+		}
+
+		[[gnu::noinline]] static bool transparent(const world_block block) noexcept
+		{
+			return block_registry::block_transparent(block.type());
+		}
+	};
+
+	//one quad per visible block face, like the mesher before column masks
+	void add_block_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const ytype::direction side, const tex_pos tile)
+	{
+		const vec3d<int> normal = ytype::direction_offset(side);
+		const vec3d<int> start = pos+vec3d<int>{std::max(normal.x, 0), std::max(normal.y, 0), std::max(normal.z, 0)};
+
+		const vec3d<int> u = normal.x!=0 ? vec3d<int>{0, 0, 1} : vec3d<int>{1, 0, 0};
+		const vec3d<int> v = normal.y!=0 ? vec3d<int>{0, 0, 1} : vec3d<int>{0, 1, 0};
+
+		for(const auto& corner : {start, start+u, start+v, start+u+v})
+			vertices.push_back(chunk_vertex::pack({corner, side, tile}));
+	}
+
+	template<typename properties>
+	size_t block_mesh(const padded_chunk& padded, chunk_mesh& mesh)
+	{
+		for(auto& vertices : mesh.opaque)
+			vertices.clear();
+
+		mesh.transparent.clear();
+
+		size_t faces = 0;
+		for(int x = 0; x < chunk_size; ++x)
+		{
+			for(int y = 0; y < chunk_size; ++y)
+			{
+				for(int z = 0; z < chunk_size; ++z)
+				{
+					const world_block c_block = padded.block({x, y, z});
+					if(c_block.type()==block::air)
+						continue;
+
+					for(const auto side : sides)
+					{
+						const world_block check = padded.block(vec3d<int>{x, y, z}+ytype::direction_offset(side));
+
+						if(!properties::transparent(check) || c_block.type()==check.type())
+							continue;
+
+						std::vector<std::uint32_t>& vertices = properties::transparent(c_block) ? mesh.transparent : mesh.opaque[static_cast<int>(side)-1];
+						add_block_face(vertices, {x, y, z}, side, properties::texture(c_block).side(side));
+
+						++faces;
+					}
+				}
+			}
+		}
+
+		return faces;
+	}
+
+	//the two lookups the mesher does for every block, without the meshing around them
+	template<typename properties>
+	int lookup_properties(const std::vector<world_block>& blocks)
+	{
+		int sum = 0;
+		for(const world_block c_block : blocks)
+			sum += properties::transparent(c_block)+properties::texture(c_block).side(ytype::direction::up).x;
+
+		return sum;
+	}
+
+	//block faces covered by the quads of a mesh
+	size_t face_area(const chunk_mesh& mesh)
+	{
+		size_t area = 0;
+
+		const auto add_area = [&area](const std::vector<std::uint32_t>& vertices)
+		{
+			for(size_t quad = 0; quad < vertices.size(); quad += 4)
+			{
+				int min_u = chunk_size, max_u = 0, min_v = chunk_size, max_v = 0;
+				for(size_t i = quad; i < quad+4; ++i)
+				{
+					const chunk_vertex::vertex c_vertex = chunk_vertex::unpack(vertices[i]);
+
+					min_u = std::min(min_u, chunk_vertex::texture_u(c_vertex));
+					max_u = std::max(max_u, chunk_vertex::texture_u(c_vertex));
+					min_v = std::min(min_v, chunk_vertex::texture_v(c_vertex));
+					max_v = std::max(max_v, chunk_vertex::texture_v(c_vertex));
+				}
+
+				area += (max_u-min_u)*(max_v-min_v);
+			}
+		};
+
+		for(const auto& vertices : mesh.opaque)
+			add_area(vertices);
+
+		add_area(mesh.transparent);
+
+		return area;
+	}
+
+	size_t quads(const chunk_mesh& mesh)
+	{
+		size_t amount = mesh.transparent.size()/4;
+		for(const auto& vertices : mesh.opaque)
+			amount += vertices.size()/4;
+
+		return amount;
+	}
+
+	template<typename F>
+	double time_us(F func)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		for(int pass = 0; pass < passes; ++pass)
+			func();
+
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now()-start).count()/passes;
+	}
+};
+
+int main()
+{
+	const bench_chunks chunks = generate_chunks(4);
+	const double amount = chunks.padded.size();
+
+	std::cout << "chunks: " << chunks.padded.size() << ", greedy meshing: " << (chunk_mesher::greedy_mesh ? "on" : "off") << std::endl;
+
+	chunk_mesh mesh;
+
+	size_t block_faces = 0;
+	size_t block_quads = 0;
+	size_t column_faces = 0;
+	size_t column_quads = 0;
+
+	for(const auto& padded : chunks.padded)
+	{
+		if(block_mesh<switch_properties>(padded, mesh)!=block_mesh<registry_properties>(padded, mesh))
+		{
+			std::cout << "property switches and registry dont match" << std::endl;
+			return 1;
+		}
+
+		block_faces += block_mesh<registry_properties>(padded, mesh);
+		block_quads += quads(mesh);
+
+		chunk_mesher(padded, mesh).build();
+		column_faces += face_area(mesh);
+		column_quads += quads(mesh);
+	}
+
+	if(block_faces!=column_faces)
+	{
+		std::cout << "visible faces dont match, per block " << block_faces << " column masks " << column_faces << std::endl;
+		return 1;
+	}
+
+	int lookup_sum = 0;
+
+	const double switch_lookup_us = time_us([&]()
+	{
+		lookup_sum += lookup_properties<switch_properties>(chunks.blocks);
+	})/amount;
+
+	const double registry_lookup_us = time_us([&]()
+	{
+		lookup_sum -= lookup_properties<registry_properties>(chunks.blocks);
+	})/amount;
+
+	if(lookup_sum!=0)
+	{
+		std::cout << "property lookups dont match" << std::endl;
+		return 1;
+	}
+
+	const double switch_us = time_us([&]()
+	{
+		for(const auto& padded : chunks.padded)
+			block_mesh<switch_properties>(padded, mesh);
+	})/amount;
+
+	const double block_us = time_us([&]()
+	{
+		for(const auto& padded : chunks.padded)
+			block_mesh<registry_properties>(padded, mesh);
+	})/amount;
+
+	const double column_us = time_us([&]()
+	{
+		for(const auto& padded : chunks.padded)
+			chunk_mesher(padded, mesh).build();
+	})/amount;
+
+	std::cout << "visible faces: " << block_faces/amount << " per chunk" << std::endl;
+	std::cout << "per block neighbour checks: " << block_us << " us per chunk, " << block_quads/amount << " quads" << std::endl;
+	std::cout << "column masks: " << column_us << " us per chunk, " << column_quads/amount << " quads" << std::endl;
+	std::cout << "speedup: " << block_us/column_us << "x" << std::endl;
+
+	std::cout << "per block with property switches: " << switch_us << " us per chunk" << std::endl;
+	std::cout << "per block with the property registry: " << block_us << " us per chunk" << std::endl;
+	std::cout << "registry speedup: " << switch_us/block_us << "x" << std::endl;
+
+	std::cout << "property lookups with switches: " << switch_lookup_us << " us per chunk" << std::endl;
+	std::cout << "property lookups with the registry: " << registry_lookup_us << " us per chunk" << std::endl;
+	std::cout << "lookup speedup: " << switch_lookup_us/registry_lookup_us << "x" << std::endl;
+
+	return 0;
+}
@@ -3,6 +3,7 @@
 #include <chrono>
 #include <execution>
 #include <cassert>
+#include <bit>
 
 #include "chunk.h"
 #include "inventory.h"
@@ -11,6 +12,30 @@
 
 using namespace world_types;
 
+dirty_chunks::dirty_chunks()
+{
+}
+
+void dirty_chunks::reserve(const int amount)
+{
+	_chunks.reserve(amount);
+}
+
+void dirty_chunks::mark(const vec3d<int> chunk) noexcept
+{
+	_chunks.push_back(chunk);
+}
+
+const std::vector<vec3d<int>>& dirty_chunks::chunks() const noexcept
+{
+	return _chunks;
+}
+
+void dirty_chunks::clear() noexcept
+{
+	_chunks.clear();
+}
+
 world_chunk::world_chunk()
 {
 }
@@ -20,26 +45,167 @@ world_chunk::world_chunk(const vec3d<int> pos)
 {
 }
 
-void world_chunk::connect_observer(chunk_observer* observer) noexcept
+void world_chunk::reset(const vec3d<int> pos) noexcept
 {
-	_observers.push_back(observer);
+	_blocks.reset(world_block{block::air});
+
+	_type_counts.fill(0);
+	_type_counts[block::air] = blocks_amount;
+	_solid_count = 0;
+	_transparent_count = blocks_amount;
+
+	_solid_columns.fill(0);
+	_transparent_columns.fill(0);
+
+	_brick_solid.fill(0);
+	_brick_opaque.fill(0);
+
+	_dirty_bricks = 0;
+
+	_dirty_set = nullptr;
+
+	_dirty_sides = wall_states{false, false, false, false, false, false};
+	_dirty = false;
+
+	_position = pos;
+
+	_empty = true;
 }
 
-void world_chunk::remove_observer(chunk_observer* observer) noexcept
+void world_chunk::set_dirty_set(dirty_chunks* dirty) noexcept
 {
-	_observers.erase(std::find(_observers.begin(), _observers.end(), observer));
+	_dirty_set = dirty;
+}
+
+wall_states world_chunk::take_dirty_sides() noexcept
+{
+	const wall_states sides = _dirty_sides;
+
+	_dirty_sides = wall_states{false, false, false, false, false, false};
+	_dirty = false;
+
+	return sides;
 }
 
 bool world_chunk::has_transparent() const noexcept
 {
-	auto iter = std::find_if(blocks.begin(), blocks.end(), [](const world_block& block){return block.transparent();});
-	return iter!=blocks.end();
+	return _transparent_count!=0;
 }
 
 bool world_chunk::check_empty() const noexcept
 {
-	auto iter = std::find_if(blocks.begin(), blocks.end(), [](const world_block& block){return block.block_type!=block::air;});
-	return iter==blocks.end();
+	return _solid_count==0;
+}
+
+bool world_chunk::check_opaque() const noexcept
+{
+	return _transparent_count==0;
+}
+
+std::uint32_t world_chunk::solid_column(const int x, const int z) const noexcept
+{
+	return _solid_columns[index_column(x, z)];
+}
+
+std::uint32_t world_chunk::transparent_column(const int x, const int z) const noexcept
+{
+	return _transparent_columns[index_column(x, z)];
+}
+
+bool world_chunk::solid(const vec3d<int> pos) const noexcept
+{
+	return (solid_column(pos.x, pos.z)>>pos.y) & 1;
+}
+
+bool world_chunk::brick_empty(const vec3d<int> brick) const noexcept
+{
+	return _brick_solid[index_brick(brick)]==0;
+}
+
+bool world_chunk::brick_opaque(const vec3d<int> brick) const noexcept
+{
+	return _brick_opaque[index_brick(brick)]==brick_volume;
+}
+
+bool world_chunk::brick_buried(const vec3d<int> brick) const noexcept
+{
+	if(!brick_opaque(brick))
+		return false;
+
+	//bricks outside of the chunk count as opaque, the mesher never skips the wall blocks
+	const auto side_opaque = [this](const vec3d<int> side)
+	{
+		if(side.x<0 || side.y<0 || side.z<0
+			|| side.x>=bricks_side || side.y>=bricks_side || side.z>=bricks_side)
+			return true;
+
+		return brick_opaque(side);
+	};
+
+	return side_opaque({brick.x+1, brick.y, brick.z}) && side_opaque({brick.x-1, brick.y, brick.z})
+		&& side_opaque({brick.x, brick.y+1, brick.z}) && side_opaque({brick.x, brick.y-1, brick.z})
+		&& side_opaque({brick.x, brick.y, brick.z+1}) && side_opaque({brick.x, brick.y, brick.z-1});
+}
+
+std::uint64_t world_chunk::dirty_bricks() const noexcept
+{
+	return _dirty_bricks;
+}
+
+std::uint64_t world_chunk::take_dirty_bricks() noexcept
+{
+	const std::uint64_t bricks = _dirty_bricks;
+	_dirty_bricks = 0;
+
+	return bricks;
+}
+
+void world_chunk::mark_dirty_bricks(const std::uint64_t bricks) noexcept
+{
+	_dirty_bricks |= bricks;
+}
+
+std::uint64_t world_chunk::neighbour_wall_bricks(const std::uint64_t bricks, const ytype::direction side) noexcept
+{
+	const vec3d<int> offset = ytype::direction_offset(side);
+
+	std::uint64_t wall_bricks = 0;
+	for(int x = 0; x < bricks_side; ++x)
+	{
+		for(int y = 0; y < bricks_side; ++y)
+		{
+			for(int z = 0; z < bricks_side; ++z)
+			{
+				const vec3d<int> brick{x, y, z};
+				const vec3d<int> neighbour_brick = brick-offset*(bricks_side-1);
+
+				//only the bricks touching the wall have a spot on the other side
+				if(neighbour_brick.x<0 || neighbour_brick.y<0 || neighbour_brick.z<0
+					|| neighbour_brick.x>=bricks_side || neighbour_brick.y>=bricks_side || neighbour_brick.z>=bricks_side)
+					continue;
+
+				if((bricks>>index_brick(brick)) & 1)
+					wall_bricks |= std::uint64_t(1)<<index_brick(neighbour_brick);
+			}
+		}
+	}
+
+	return wall_bricks;
+}
+
+int world_chunk::block_count(const world_types::block type) const noexcept
+{
+	return _type_counts[type];
+}
+
+int world_chunk::solid_count() const noexcept
+{
+	return _solid_count;
+}
+
+int world_chunk::transparent_count() const noexcept
+{
+	return _transparent_count;
 }
 
 
@@ -48,7 +214,8 @@ void world_chunk::update_states()
 	if(_empty)
 		return;
 
-	std::for_each(blocks.begin(), blocks.end(), [](world_block& block)
+	//blocks dont know their position so updating each unique block is enough
+	_blocks.for_each_entry([](world_block& block)
 	{
 			block.update();
 	});
@@ -107,19 +274,90 @@ wall_states world_chunk::block_sides(const vec3d<int> pos) noexcept
 
 void world_chunk::set_block(const world_block block, const vec3d<int> pos) noexcept
 {
-	blocks[index_block(pos)] = block;
+	const world_block old_block = _blocks.set(index_block(pos), block);
+
+	if(old_block==block)
+		return;
+
+	count_block(old_block, -1);
+	count_block(block, 1);
 
-	notify_observers(_position, pos);
+	const int brick = index_brick({pos.x/brick_size, pos.y/brick_size, pos.z/brick_size});
+
+	count_brick(old_block, brick, -1);
+	count_brick(block, brick, 1);
+
+	update_columns(block, pos);
+
+	mark_dirty(pos);
 }
 
-world_block& world_chunk::block(const vec3d<int> pos) noexcept
+void world_chunk::fill(const world_block block) noexcept
 {
-	return blocks[index_block(pos)];
+	_blocks.fill(block);
+
+	_type_counts.fill(0);
+	_solid_count = 0;
+	_transparent_count = 0;
+
+	count_block(block, blocks_amount);
+
+	_brick_solid.fill(block.solid() ? brick_volume : 0);
+	_brick_opaque.fill(block.solid() && !block.transparent() ? brick_volume : 0);
+
+	const bool is_solid = block.solid();
+	_solid_columns.fill(is_solid ? ~std::uint32_t(0) : 0);
+	_transparent_columns.fill(is_solid && block.transparent() ? ~std::uint32_t(0) : 0);
+}
+
+world_block world_chunk::block(const vec3d<int> pos) const noexcept
+{
+	return _blocks.get(index_block(pos));
+}
+
+bool world_chunk::uniform() const noexcept
+{
+	return _blocks.uniform();
 }
 
-const world_block& world_chunk::block(const vec3d<int> pos) const noexcept
+world_block world_chunk::uniform_block() const noexcept
 {
-	return blocks[index_block(pos)];
+	assert(uniform());
+	return _blocks.get(0);
+}
+
+world_block world_chunk::cell_block(const vec3d<int> cell, const int scale) const noexcept
+{
+	const std::uint32_t cell_mask = (std::uint32_t(1)<<scale)-1;
+
+	int solid = 0;
+
+	int top = -1;
+	vec3d<int> top_pos{0, 0, 0};
+
+	for(int x = cell.x*scale; x < (cell.x+1)*scale; ++x)
+	{
+		for(int z = cell.z*scale; z < (cell.z+1)*scale; ++z)
+		{
+			const std::uint32_t bits = (solid_column(x, z)>>(cell.y*scale)) & cell_mask;
+			if(bits==0)
+				continue;
+
+			solid += std::popcount(bits);
+
+			const int height = std::bit_width(bits)-1;
+			if(height>top)
+			{
+				top = height;
+				top_pos = {x, cell.y*scale+height, z};
+			}
+		}
+	}
+
+	if(solid*2 < scale*scale*scale)
+		return world_block{block::air};
+
+	return block(top_pos);
 }
 
 void world_chunk::set_empty(const bool state) noexcept
@@ -137,16 +375,80 @@ const vec3d<int> world_chunk::position() const noexcept
 	return _position;
 }
 
+size_t world_chunk::memory_usage() const noexcept
+{
+	return sizeof(*this)-sizeof(_blocks)+_blocks.memory_usage();
+}
+
 int world_chunk::index_block(const vec3d<int> pos) noexcept
 {
-	assert((pos.x*chunk_size*chunk_size+pos.y*chunk_size+pos.z)<(chunk_size*chunk_size*chunk_size));
-	return pos.x*chunk_size*chunk_size+pos.y*chunk_size+pos.z;
+	assert(pos.x>=0 && pos.y>=0 && pos.z>=0 && pos.x<chunk_size && pos.y<chunk_size && pos.z<chunk_size);
+	return chunk_layout::current::index(pos);
+}
+
+int world_chunk::index_column(const int x, const int z) noexcept
+{
+	return x*chunk_size+z;
 }
 
-void world_chunk::notify_observers(const vec3d<int> chunk, const vec3d<int> pos) noexcept
+int world_chunk::index_brick(const vec3d<int> brick) noexcept
 {
-	std::for_each(_observers.begin(), _observers.end(), [&chunk, &pos](chunk_observer* observer)
+	return brick.x*bricks_side*bricks_side+brick.y*bricks_side+brick.z;
+}
+
+void world_chunk::mark_dirty(const vec3d<int> pos) noexcept
+{
+	if(_dirty_set==nullptr)
+		return;
+
+	if(!_dirty)
 	{
-		observer->block_notify(chunk, pos);
-	});
-}
\ No newline at end of file
+		_dirty = true;
+		_dirty_set->mark(_position);
+	}
+
+	_dirty_sides.add_walls(block_sides(pos));
+
+	//faces of the blocks next to the edited one change too, they can be in the neighbouring bricks
+	for(const vec3d<int> offset : {vec3d<int>{0, 0, 0}, vec3d<int>{1, 0, 0}, vec3d<int>{-1, 0, 0},
+		vec3d<int>{0, 1, 0}, vec3d<int>{0, -1, 0}, vec3d<int>{0, 0, 1}, vec3d<int>{0, 0, -1}})
+	{
+		const vec3d<int> c_pos = pos+offset;
+		if(c_pos.x<0 || c_pos.y<0 || c_pos.z<0 || c_pos.x>=chunk_size || c_pos.y>=chunk_size || c_pos.z>=chunk_size)
+			continue;
+
+		_dirty_bricks |= std::uint64_t(1)<<index_brick(c_pos/brick_size);
+	}
+}
+
+void world_chunk::count_block(const world_block block, const int amount) noexcept
+{
+	_type_counts[block.type()] += amount;
+
+	if(block.solid())
+		_solid_count += amount;
+
+	if(block.transparent())
+		_transparent_count += amount;
+}
+
+void world_chunk::update_columns(const world_block block, const vec3d<int> pos) noexcept
+{
+	const int column = index_column(pos.x, pos.z);
+	const std::uint32_t bit = std::uint32_t(1)<<pos.y;
+
+	const bool is_solid = block.solid();
+
+	_solid_columns[column] = is_solid ? (_solid_columns[column] | bit) : (_solid_columns[column] & ~bit);
+	_transparent_columns[column] = is_solid && block.transparent()
+		? (_transparent_columns[column] | bit) : (_transparent_columns[column] & ~bit);
+}
+
+void world_chunk::count_brick(const world_block block, const int brick, const int amount) noexcept
+{
+	if(block.solid())
+		_brick_solid[brick] += amount;
+
+	if(block.solid() && !block.transparent())
+		_brick_opaque[brick] += amount;
+}
@@ -2,29 +2,52 @@
 #define Y_CHUNK_H
 
 #include <vector>
+#include <array>
 #include <memory>
 #include <mutex>
+#include <cstdint>
 
 #include "wblock.h"
+#include "cpalette.h"
+#include "clayout.h"
 
-class chunk_observer
+//chunks edited since the last time the set was drained
+class dirty_chunks
 {
 public:
-	virtual ~chunk_observer() = default;
+	dirty_chunks();
 
-	virtual void block_notify(const vec3d<int> chunk, const vec3d<int> pos) = 0;
+	void reserve(const int amount);
+
+	void mark(const vec3d<int> chunk) noexcept;
+
+	const std::vector<vec3d<int>>& chunks() const noexcept;
+	void clear() noexcept;
+
+private:
+	std::vector<vec3d<int>> _chunks;
 };
 
 class world_chunk
 {
 public:
-	typedef std::array<world_block, world_types::chunk_size*world_types::chunk_size*world_types::chunk_size> chunk_blocks;
+	static constexpr int blocks_amount = world_types::chunk_size*world_types::chunk_size*world_types::chunk_size;
+
+	static constexpr int brick_size = 8;
+	static constexpr int bricks_side = world_types::chunk_size/brick_size;
+	static constexpr int bricks_amount = bricks_side*bricks_side*bricks_side;
+	static constexpr int brick_volume = brick_size*brick_size*brick_size;
 
 	world_chunk();
 	world_chunk(const vec3d<int> pos);
+
+	//turns the chunk back into a new empty one at pos, keeps its block storage allocated
+	void reset(const vec3d<int> pos) noexcept;
 	
-	void connect_observer(chunk_observer* observer) noexcept;
-	void remove_observer(chunk_observer* observer) noexcept;
+	void set_dirty_set(dirty_chunks* dirty) noexcept;
+
+	//sides touched by edits since the chunk was marked dirty, unmarks it
+	world_types::wall_states take_dirty_sides() noexcept;
 
 	void update_states();
 	
@@ -37,25 +60,84 @@ public:
 	static world_types::wall_states block_sides(const vec3d<int> pos) noexcept;
 	
 	void set_block(const world_block block, const vec3d<int> pos) noexcept;
+	void fill(const world_block block) noexcept;
 
-	world_block& block(const vec3d<int> pos) noexcept;
-	const world_block& block(const vec3d<int> pos) const noexcept;
+	world_block block(const vec3d<int> pos) const noexcept;
 	
+	bool uniform() const noexcept;
+	world_block uniform_block() const noexcept;
+
+	//cells are scale^3 blocks, they take the highest block in them or air if less than half of them is solid
+	world_block cell_block(const vec3d<int> cell, const int scale) const noexcept;
+
 	void set_empty(const bool state) noexcept;
 	bool empty() const noexcept;
 	bool has_transparent() const noexcept;
 	bool check_empty() const noexcept;
+	bool check_opaque() const noexcept;
+
+	//one bit per block along the y axis
+	std::uint32_t solid_column(const int x, const int z) const noexcept;
+	std::uint32_t transparent_column(const int x, const int z) const noexcept;
+
+	bool solid(const vec3d<int> pos) const noexcept;
+
+	//bricks are brick_size^3 sections of the chunk
+	bool brick_empty(const vec3d<int> brick) const noexcept;
+	bool brick_opaque(const vec3d<int> brick) const noexcept;
+	bool brick_buried(const vec3d<int> brick) const noexcept;
+
+	//one bit per brick whose faces changed since the last take, edits also mark the bricks next to them
+	std::uint64_t dirty_bricks() const noexcept;
+	std::uint64_t take_dirty_bricks() noexcept;
+	void mark_dirty_bricks(const std::uint64_t bricks) noexcept;
+
+	//dirty bricks on the wall facing side, moved over to the same spots on the neighbours wall facing back
+	static std::uint64_t neighbour_wall_bricks(const std::uint64_t bricks, const ytype::direction side) noexcept;
+
+	int block_count(const world_types::block type) const noexcept;
+	int solid_count() const noexcept;
+	int transparent_count() const noexcept;
 	
 	const vec3d<int> position() const noexcept;
 
-	static int index_block(const vec3d<int> pos) noexcept;
+	size_t memory_usage() const noexcept;
 
-	chunk_blocks blocks;
+	static int index_block(const vec3d<int> pos) noexcept;
+	static int index_column(const int x, const int z) noexcept;
+	static int index_brick(const vec3d<int> brick) noexcept;
 
 private:
-	void notify_observers(const vec3d<int> chunk, const vec3d<int> pos) noexcept;
+	void mark_dirty(const vec3d<int> pos) noexcept;
+
+	void count_block(const world_block block, const int amount) noexcept;
+	void update_columns(const world_block block, const vec3d<int> pos) noexcept;
+	void count_brick(const world_block block, const int brick, const int amount) noexcept;
+
+	chunk_palette _blocks{blocks_amount, world_block{world_types::block::air}};
+
+	//kept up to date on every write
+	std::array<int, world_types::block::bLAST> _type_counts{blocks_amount};
+	int _solid_count = 0;
+	int _transparent_count = blocks_amount;
+
+	static_assert(world_types::chunk_size<=32, "chunk columns must fit in 32 bits");
+	typedef std::array<std::uint32_t, world_types::chunk_size*world_types::chunk_size> chunk_columns;
+
+	//transparent columns only have bits for non air blocks
+	chunk_columns _solid_columns{};
+	chunk_columns _transparent_columns{};
+
+	std::array<std::uint16_t, bricks_amount> _brick_solid{};
+	std::array<std::uint16_t, bricks_amount> _brick_opaque{};
+
+	static_assert(bricks_amount<=64, "brick flags must fit in 64 bits");
+	std::uint64_t _dirty_bricks = 0;
+
+	dirty_chunks* _dirty_set = nullptr;
 
-	std::vector<chunk_observer*> _observers;
+	world_types::wall_states _dirty_sides{false, false, false, false, false, false};
+	bool _dirty = false;
 
 	vec3d<int> _position;
 	
@@ -0,0 +1,50 @@
+#ifndef Y_CLAYOUT_H
+#define Y_CLAYOUT_H
+
+#include "types.h"
+#include "worldtypes.h"
+
+
+//order of blocks inside of a chunk, picked at compile time with Y_MORTON_LAYOUT
+namespace chunk_layout
+{
+	//x major, z is the fastest changing axis
+	struct linear
+	{
+		static constexpr int index(const vec3d<int> pos) noexcept
+		{
+			return pos.x*world_types::chunk_size*world_types::chunk_size+pos.y*world_types::chunk_size+pos.z;
+		}
+	};
+
+	//z order curve, neighbours on every axis tend to stay close in memory
+	struct morton
+	{
+		static constexpr int spread_bits(const int val) noexcept
+		{
+			int spread = 0;
+			for(int i = 0; (1<<i) < world_types::chunk_size; ++i)
+			{
+				spread |= ((val>>i) & 1)<<(i*3);
+			}
+
+			return spread;
+		}
+
+		static constexpr int index(const vec3d<int> pos) noexcept
+		{
+			return (spread_bits(pos.x)<<2) | (spread_bits(pos.y)<<1) | spread_bits(pos.z);
+		}
+	};
+
+	static_assert((world_types::chunk_size & (world_types::chunk_size-1))==0,
+		"morton order needs a power of 2 chunk size");
+
+	#ifdef Y_MORTON_LAYOUT
+	typedef morton current;
+	#else
+	typedef linear current;
+	#endif
+};
+
+#endif
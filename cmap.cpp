@@ -1,4 +1,7 @@
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
 
 #include "cmap.h"
 #include "wgen.h"
@@ -10,8 +13,9 @@ storage::storage()
 {
 }
 
-storage::storage(controller* owner, world_generator* generator, const int size)
-: chunks(size), _owner(owner), _generator(generator), _chunks_amount(size)
+storage::storage(controller* owner, world_generator* generator, const graphics_state& graphics, const int size)
+: chunks(size, full_chunk(world_chunk(), graphics)), _owner(owner), _generator(generator), _chunks_amount(size),
+_generations(size, 0), _generating(size, false)
 {
 	_open_spots.reserve(_chunks_amount);
 	for(int i = 0; i < _chunks_amount; ++i)
@@ -60,53 +64,86 @@ storage& storage::operator=(storage&& other) noexcept
 	return *this;
 }
 
-void storage::generate_chunk(const vec3d<int> pos)
+bool storage::generate_chunk(const vec3d<int> pos)
 {
 	assert(_generator!=nullptr);
 
-	full_chunk f_chunk = _generator->full_chunk_gen(pos);
+	chunk_handle handle;
+
+	{
+		std::unique_lock lock(chunk_gen_mtx);
+
+		//spots get freed on the main thread, never throw on a worker
+		_open_spots_cv.wait(lock, [this](){return _closed || !_open_spots.empty();});
+
+		if(_closed)
+			return false;
+
+		handle = chunk_handle{_open_spots.back(), _generations[_open_spots.back()]};
+
+		_open_spots.pop_back();
+		_generating[handle.index] = true;
+	}
+
+	//only the blocks are made here, models stay in their spots and get reset on the main thread
+	//nothing else touches a taken slot until its handle is processed
+	_generator->chunk_gen(chunks[handle.index].chunk, pos);
 
 
 	std::lock_guard lock(chunk_gen_mtx);
 
-	if(_open_spots.empty())
-		throw std::runtime_error("_open_spots is empty");
-	const int open_index = _open_spots.back();
-	full_chunk& c_chunk = chunks[open_index];
+	_generating[handle.index] = false;
+	processed_chunks.push_back(handle);
+
+	return true;
+}
 
-	c_chunk = std::move(f_chunk);
-	processed_chunks.push_back(&c_chunk);
+void storage::close() noexcept
+{
+	{
+		std::lock_guard lock(chunk_gen_mtx);
+		_closed = true;
+	}
 
-	_open_spots.pop_back();
+	_open_spots_cv.notify_all();
 }
 
-void storage::remove_chunk(container_type::iterator chunk)
+full_chunk* storage::get(const chunk_handle handle) noexcept
 {
-	std::lock_guard lock(chunk_gen_mtx);
+	if(handle.index<0 || handle.index>=_chunks_amount || _generations[handle.index]!=handle.generation)
+		return nullptr;
 
-	remove_chunk(*chunk, std::distance(chunks.begin(), chunk));
+	return &chunks[handle.index];
 }
 
-void storage::remove_chunk(full_chunk& chunk)
+const full_chunk* storage::get(const chunk_handle handle) const noexcept
 {
-	std::lock_guard lock(chunk_gen_mtx);
+	if(handle.index<0 || handle.index>=_chunks_amount || _generations[handle.index]!=handle.generation)
+		return nullptr;
 
-	for(int i = 0; i < chunks.size(); ++i)
-	{
-		if((chunks.data()+i)==&chunk)
-		{
-			remove_chunk(chunk, i);
-			return;
-		}
-	}
+	return &chunks[handle.index];
+}
+
+void storage::remove_chunk(const chunk_handle handle)
+{
+	std::lock_guard lock(chunk_gen_mtx);
 
 	//if chunk not found then ignore
+	if(get(handle)==nullptr)
+		return;
+
+	remove_chunk(handle.index);
 }
 
-void storage::remove_chunk(full_chunk& chunk, const int index)
+void storage::remove_chunk(const int index)
 {
+	++_generations[index];
+
 	_open_spots.push_back(index);
-	chunk.chunk.set_empty(true);
+	chunks[index].chunk.set_empty(true);
+	chunks[index].model.clear();
+
+	_open_spots_cv.notify_one();
 }
 
 void storage::clear() noexcept
@@ -119,18 +156,22 @@ void storage::clear() noexcept
 	_open_spots.reserve(_chunks_amount);
 	for(int i = 0; i < _chunks_amount; ++i)
 	{
-		_open_spots.emplace_back(i);
+		if(!_generating[i])
+			remove_chunk(i);
 	}
 }
 
 void storage::copy_members(const storage& other)
 {
 	chunks = other.chunks;
-	processed_chunks = ref_container_type();
+	processed_chunks = handle_container_type();
 
 	_chunks_amount = other._chunks_amount;
 
 	_open_spots = other._open_spots;
+	_closed = other._closed;
+	_generations = other._generations;
+	_generating = other._generating;
 	_owner = other._owner;
 	_generator = other._generator;
 }
@@ -138,33 +179,205 @@ void storage::copy_members(const storage& other)
 void storage::move_members(storage&& other) noexcept
 {
 	chunks = std::move(other.chunks);
-	processed_chunks = ref_container_type();
+	processed_chunks = handle_container_type();
 
 	_chunks_amount = other._chunks_amount;
 
 	_open_spots = std::move(other._open_spots);
+	_closed = other._closed;
+	_generations = std::move(other._generations);
+	_generating = std::move(other._generating);
 	_owner = other._owner;
 	_generator = other._generator;
 }
 
-controller::iterator::iterator(const value_type* end, pointer p)
-: _end_ptr(end), _ptr(p)
+mesh_workers::mesh_workers(const int threads)
+{
+	_mesh_pool = std::make_unique<mesh_pool_type>(threads,
+		&mesh_workers::build, this, nullptr);
+}
+
+mesh_workers::~mesh_workers()
+{
+	_mesh_pool->exit_threads();
+}
+
+void mesh_workers::run(const std::shared_ptr<remesh_job> job)
+{
+	_mesh_pool->run(job);
+}
+
+std::vector<std::shared_ptr<remesh_job>> mesh_workers::take_finished()
+{
+	std::lock_guard lock(_finished_mtx);
+
+	std::vector<std::shared_ptr<remesh_job>> finished;
+	finished.swap(_finished);
+
+	return finished;
+}
+
+mesh_cache::counters mesh_workers::cache_counters() const noexcept
+{
+	return _cache.cache_counters();
+}
+
+void mesh_workers::build(const std::shared_ptr<remesh_job> job)
+{
+	if(!job)
+		return;
+
+	const std::optional<mesh_key> key = job->chunk.cache_key();
+
+	if(key)
+		job->mesh = _cache.find(*key);
+
+	if(!job->mesh)
+	{
+		job->chunk.downsample();
+
+		std::shared_ptr<chunk_mesh> mesh = std::make_shared<chunk_mesh>();
+
+		chunk_mesher mesher(job->chunk, *mesh);
+		if(job->base)
+			mesher.rebuild(*job->base, job->dirty_bricks);
+		else
+			mesher.build();
+
+		if(key)
+			_cache.insert(*key, mesh);
+
+		job->mesh = mesh;
+	}
+
+	std::lock_guard lock(_finished_mtx);
+	_finished.push_back(job);
+}
+
+generator_workers::generator_workers(storage* chunks, const int threads, const vec3d<int> render_size, const vec3d<int> center)
+: _chunks(chunks), _render_size(render_size), _center(center)
+{
+	_threads.reserve(threads);
+	for(int i = 0; i < threads; ++i)
+		_threads.emplace_back(&generator_workers::work, this);
+}
+
+generator_workers::~generator_workers()
+{
+	{
+		std::lock_guard lock(_queue_mtx);
+		_exit = true;
+	}
+
+	_queue_cv.notify_all();
+	_chunks->close();
+
+	for(auto& thread : _threads)
+		thread.join();
+}
+
+void generator_workers::run(const std::vector<vec3d<int>>& positions)
+{
+	if(positions.empty())
+		return;
+
+	{
+		std::lock_guard lock(_queue_mtx);
+
+		_queue.insert(_queue.end(), positions.begin(), positions.end());
+		std::make_heap(_queue.begin(), _queue.end(), [this](const auto& lhs, const auto& rhs){return later(lhs, rhs);});
+	}
+
+	_queue_cv.notify_all();
+}
+
+void generator_workers::update_center(const vec3d<int> center)
+{
+	std::lock_guard lock(_queue_mtx);
+
+	_center = center;
+
+	std::erase_if(_queue, [this](const vec3d<int> pos){return !in_range(pos);});
+	std::make_heap(_queue.begin(), _queue.end(), [this](const auto& lhs, const auto& rhs){return later(lhs, rhs);});
+}
+
+void generator_workers::update_view(const vec3d<float> direction)
+{
+	std::lock_guard lock(_queue_mtx);
+
+	const float turned = direction.x*_view.x+direction.y*_view.y+direction.z*_view.z;
+	if(turned>view_threshold)
+		return;
+
+	_view = direction;
+
+	std::make_heap(_queue.begin(), _queue.end(), [this](const auto& lhs, const auto& rhs){return later(lhs, rhs);});
+}
+
+void generator_workers::work()
+{
+	while(true)
+	{
+		vec3d<int> pos;
+
+		{
+			std::unique_lock lock(_queue_mtx);
+			_queue_cv.wait(lock, [this](){return _exit || !_queue.empty();});
+
+			if(_exit)
+				return;
+
+			std::pop_heap(_queue.begin(), _queue.end(), [this](const auto& lhs, const auto& rhs){return later(lhs, rhs);});
+			pos = _queue.back();
+			_queue.pop_back();
+		}
+
+		if(!_chunks->generate_chunk(pos))
+			return;
+	}
+}
+
+bool generator_workers::in_range(const vec3d<int> pos) const noexcept
+{
+	return std::abs(pos.x-_center.x)<=_render_size.x
+		&& std::abs(pos.y-_center.y)<=_render_size.y
+		&& std::abs(pos.z-_center.z)<=_render_size.z;
+}
+
+bool generator_workers::later(const vec3d<int> lhs, const vec3d<int> rhs) const noexcept
+{
+	return priority(lhs)>priority(rhs);
+}
+
+float generator_workers::priority(const vec3d<int> pos) const noexcept
+{
+	const vec3d<float> offset = (pos-_center).cast<float>();
+
+	const float distance = std::sqrt(offset.x*offset.x+offset.y*offset.y+offset.z*offset.z);
+	const float facing = offset.x*_view.x+offset.y*_view.y+offset.z*_view.z;
+
+	//squared distance scaled by one minus view_weight times the cosine to the view direction
+	return distance*distance-view_weight*distance*facing;
+}
+
+controller::iterator::iterator(storage* chunks, const chunk_handle* end, const chunk_handle* p)
+: _chunks(chunks), _end_ptr(end), _ptr(p)
 {
 }
 
 controller::iterator::reference controller::iterator::operator*() const
 {
-	return **_ptr;
+	return *_chunks->get(*_ptr);
 }
 
 controller::iterator::value_type controller::iterator::operator->()
 {
-	return *_ptr;
+	return _chunks->get(*_ptr);
 }
 
 controller::iterator& controller::iterator::operator++()
 {
-	while(++_ptr!=_end_ptr && *_ptr==nullptr);
+	while(++_ptr!=_end_ptr && _chunks->get(*_ptr)==nullptr);
 	return *this;
 }
 
@@ -188,24 +401,24 @@ namespace cmap
 	}
 };
 
-controller::const_iterator::const_iterator(pointer end, pointer p)
-: _end_ptr(end), _ptr(p)
+controller::const_iterator::const_iterator(const storage* chunks, const chunk_handle* end, const chunk_handle* p)
+: _chunks(chunks), _end_ptr(end), _ptr(p)
 {
 }
 
 controller::const_iterator::reference controller::const_iterator::operator*() const
 {
-	return **_ptr;
+	return *_chunks->get(*_ptr);
 }
 
 controller::const_iterator::value_type controller::const_iterator::operator->() const
 {
-	return *_ptr;
+	return _chunks->get(*_ptr);
 }
 
 controller::const_iterator& controller::const_iterator::operator++()
 {
-	while(++_ptr!=_end_ptr && *_ptr==nullptr);
+	while(++_ptr!=_end_ptr && _chunks->get(*_ptr)==nullptr);
 	return *this;
 }
 
@@ -233,44 +446,62 @@ controller::controller()
 {
 }
 
-controller::controller(world_generator* generator,
-	const int render_size, const vec3d<int> center_pos)
-: _generator(generator),
-_render_size(render_size), _row_size(1+render_size*2),
-_chunks_amount(_row_size*_row_size*_row_size),
+controller::controller(world_generator* generator, const graphics_state& graphics,
+	const int render_size, const int vertical_size, const vec3d<int> center_pos)
+: _generator(generator), _graphics(graphics),
+_render_size{render_size, vertical_size, render_size},
+_row_size{1+render_size*2, 1+vertical_size*2, 1+render_size*2},
+_chunks_amount(_row_size.x*_row_size.y*_row_size.z),
 _center_pos(center_pos),
-_chunks(this, generator, _chunks_amount),
-_chunks_map(_chunks_amount, nullptr),
+_chunks(this, generator, graphics, _chunks_amount+generator_threads()),
+_chunks_map(_chunks_amount),
 _status_flags(_chunks_amount, false)
 {
+	_dirty_chunks.reserve(_chunks_amount);
+
 	generate_all();
 }
 
 void controller::generate_all() noexcept
 {
 	generate_pool();
+	generate_mesh_pool();
 
 	generate_missing();
 }
 
 void controller::generate_pool() noexcept
+{
+	_generator_workers = std::make_unique<generator_workers>(&_chunks, generator_threads(), _render_size, _center_pos);
+}
+
+int controller::generator_threads() noexcept
 {
 	const int max_threads = std::thread::hardware_concurrency();
-	const int chunk_load_threads = std::max(1, max_threads-2);
 
-	_chunk_gen_pool = std::make_unique<cgen_pool_type>(chunk_load_threads,
-		&storage::generate_chunk, &_chunks, vec3d<int>{});
+	return std::max(1, max_threads-2);
+}
+
+void controller::generate_mesh_pool() noexcept
+{
+	const int max_threads = std::thread::hardware_concurrency();
+	const int mesh_threads = std::max(1, max_threads/4);
+
+	_meshing_chunks.clear();
+	_mesh_workers = std::make_unique<mesh_workers>(mesh_threads);
 }
 
 controller::controller(const controller& other)
 : _center_pos(other._center_pos),
 _render_size(other._render_size), _row_size(other._row_size),
 _chunks_amount(other._chunks_amount),
-_generator(other._generator),
-_chunks(this, _generator, _chunks_amount),
-_chunks_map(_chunks_amount, nullptr),
+_generator(other._generator), _graphics(other._graphics),
+_chunks(this, _generator, _graphics, _chunks_amount+generator_threads()),
+_chunks_map(_chunks_amount),
 _status_flags(_chunks_amount, false)
 {
+	_dirty_chunks.reserve(_chunks_amount);
+
 	generate_all();
 }
 
@@ -285,12 +516,18 @@ controller& controller::operator=(const controller&& other)
 		_chunks_amount = other._chunks_amount;
 
 		_generator = other._generator;
+		_graphics = other._graphics;
 
-		_chunks = storage(this, _generator, _chunks_amount);
+		//the old threads still write into the storage
+		_generator_workers = nullptr;
 
-		_chunks_map = std::vector<full_chunk*>(_chunks_amount, nullptr);
+		_chunks = storage(this, _generator, _graphics, _chunks_amount+generator_threads());
+
+		_chunks_map = handle_container_type(_chunks_amount);
 		_status_flags = std::vector<bool>(_chunks_amount, false);
 
+		_dirty_chunks.reserve(_chunks_amount);
+
 		generate_all();
 	}
 	return *this;
@@ -298,41 +535,209 @@ controller& controller::operator=(const controller&& other)
 
 void controller::update() noexcept
 {
+	//new chunks and the structures reaching into them get remeshed once on commit
+	begin_edit();
+
 	connect_processed();
+	place_generated();
+
+	commit_edit();
 }
 
 void controller::update_center(const vec3d<int> pos)
 {
-	const bool missing = reassign_chunks(pos);
+	const std::vector<int> freed_slots = reassign_chunks(pos);
 
+	const vec3d<int> old_center = _center_pos;
 	_center_pos = pos;
 
-	if(missing)
-		generate_missing();
+	update_lods(old_center);
+
+	generate_missing(freed_slots);
+}
+
+void controller::update_view(const vec3d<float> direction)
+{
+	const float length = std::sqrt(direction.x*direction.x+direction.y*direction.y+direction.z*direction.z);
+	if(length==0)
+		return;
+
+	_generator_workers->update_view(direction*(1/length));
+}
+
+void controller::update_lods(const vec3d<int> old_center) noexcept
+{
+	const vec3d<int> offset = _center_pos-old_center;
+	const int moved = std::max({std::abs(offset.x), std::abs(offset.y), std::abs(offset.z)});
+
+	if(moved==0)
+		return;
+
+	const auto check_chunk = [this, old_center](const vec3d<int> c_pos)
+	{
+		if(!contains(c_pos))
+			return;
+
+		const world_chunk& c_chunk = at(c_pos).chunk;
+		if(c_chunk.empty() || c_chunk.check_empty())
+			return;
+
+		if(lod_scale(c_pos, old_center)==lod_scale(c_pos, _center_pos))
+			return;
+
+		//the neighbours padding depends on the lod too
+		_remesh_chunks.push_back(c_pos);
+		queue_chunks(c_pos, world_types::wall_states{});
+	};
+
+	//distances to the center change by at most moved, so only the shells around the lod borders can change lod
+	for(const int border : {lod_distance, lod_distance*2})
+	{
+		const int near = border-moved;
+		const int far = border+moved-1;
+
+		const vec3d<int> far_axis{std::min(far, _render_size.x), std::min(far, _render_size.y), std::min(far, _render_size.z)};
+
+		if(std::max({far_axis.x, far_axis.y, far_axis.z})<near)
+			continue;
+
+		for(int x = -far_axis.x; x <= far_axis.x; ++x)
+		{
+			for(int y = -far_axis.y; y <= far_axis.y; ++y)
+			{
+				const int xy_distance = std::max(std::abs(x), std::abs(y));
+
+				for(int z = -far_axis.z; z <= far_axis.z; ++z)
+				{
+					//skip the inside of the shell
+					if(xy_distance<near && z>-near && z<near)
+					{
+						z = near;
+
+						if(z>far_axis.z)
+							break;
+					}
+
+					check_chunk(_center_pos+vec3d<int>{x, y, z});
+				}
+			}
+		}
+	}
+
+	remesh_chunks();
+}
+
+int controller::lod_scale(const vec3d<int> pos, const vec3d<int> center) noexcept
+{
+	const vec3d<int> offset = pos-center;
+	const int distance = std::max({std::abs(offset.x), std::abs(offset.y), std::abs(offset.z)});
+
+	if(distance<lod_distance)
+		return 1;
+	else if(distance<lod_distance*2)
+		return 2;
+	else
+		return 4;
+}
+
+void controller::update_dirty() noexcept
+{
+	if(_edit_depth!=0)
+		return;
+
+	for(const auto& pos : _dirty_chunks.chunks())
+	{
+		if(!contains(pos))
+			continue;
+
+		world_chunk& c_chunk = at(pos).chunk;
+		if(c_chunk.position()!=pos)
+			continue;
+
+		_edited_chunks.push_back(pos);
+
+		//the neighbours only need their walls facing the edits meshed again
+		const world_types::wall_states dirty_sides = c_chunk.take_dirty_sides();
+		for(const auto side : {ytype::direction::left, ytype::direction::right, ytype::direction::forward,
+			ytype::direction::back, ytype::direction::down, ytype::direction::up})
+		{
+			const vec3d<int> side_pos = pos+direction_offset(side);
+			if(!dirty_sides.side(side) || !contains(side_pos))
+				continue;
+
+			at(side_pos).chunk.mark_dirty_bricks(world_chunk::neighbour_wall_bricks(c_chunk.dirty_bricks(), side));
+			_edited_chunks.push_back(side_pos);
+		}
+	}
+
+	_dirty_chunks.clear();
+
+	remesh_chunks();
+}
+
+void controller::update_meshes() noexcept
+{
+	for(const auto& job : _mesh_workers->take_finished())
+	{
+		const vec3d<int> pos = job->chunk.chunk().position();
+
+		const auto meshing = _meshing_chunks.find(pos);
+		if(meshing!=_meshing_chunks.end())
+		{
+			//edited while the job was running, the mesh is still better than the old one
+			if(meshing->second==remesh_type::full)
+				_remesh_chunks.push_back(pos);
+			else if(meshing->second==remesh_type::edited)
+				_edited_chunks.push_back(pos);
+
+			_meshing_chunks.erase(meshing);
+		}
+
+		//set before the next remesh so its edits go on top of this mesh
+		if(contains(pos) && at(pos).chunk.position()==pos)
+			at(pos).model.set_mesh(job->mesh);
+	}
+
+	remesh_chunks();
 }
 
-void controller::block_notify(const vec3d<int> chunk, const vec3d<int> pos)
+mesh_cache::counters controller::mesh_cache_counters() const noexcept
 {
-	update_chunk(chunk);
+	if(!_mesh_workers)
+		return mesh_cache::counters{};
 
-	update_chunks(chunk, world_chunk::block_sides(pos));
+	return _mesh_workers->cache_counters();
+}
+
+void controller::begin_edit() noexcept
+{
+	++_edit_depth;
+}
+
+void controller::commit_edit() noexcept
+{
+	assert(_edit_depth>0);
+
+	--_edit_depth;
+
+	update_dirty();
 }
 
 full_chunk& controller::at(const vec3d<int> pos)
 {
-	return *(_chunks_map[index_chunk(pos)]);
+	return *_chunks.get(_chunks_map[index_chunk(pos)]);
 }
 
 const full_chunk& controller::at(const vec3d<int> pos) const
 {
-	return *(_chunks_map[index_chunk(pos)]);
+	return *_chunks.get(_chunks_map[index_chunk(pos)]);
 }
 
 vec3d<int> controller::difference(const vec3d<int> pos) const noexcept
 {
-	return {(pos.x+_render_size)-(_center_pos.x+_render_size),
-		(pos.y+_render_size)-(_center_pos.y+_render_size),
-		(pos.z+_render_size)-(_center_pos.z+_render_size)};
+	return {(pos.x+_render_size.x)-(_center_pos.x+_render_size.x),
+		(pos.y+_render_size.y)-(_center_pos.y+_render_size.y),
+		(pos.z+_render_size.z)-(_center_pos.z+_render_size.z)};
 }
 
 bool controller::in_bounds(const vec3d<int> pos) const noexcept
@@ -342,9 +747,9 @@ bool controller::in_bounds(const vec3d<int> pos) const noexcept
 
 bool controller::in_local_bounds(const vec3d<int> rel_pos) const noexcept
 {
-	return rel_pos.x < _row_size && rel_pos.x >= 0
-		&& rel_pos.y < _row_size && rel_pos.y >= 0
-		&& rel_pos.z < _row_size && rel_pos.z >= 0;
+	return rel_pos.x < _row_size.x && rel_pos.x >= 0
+		&& rel_pos.y < _row_size.y && rel_pos.y >= 0
+		&& rel_pos.z < _row_size.z && rel_pos.z >= 0;
 }
 
 bool controller::contains(const vec3d<int> pos) const noexcept
@@ -360,7 +765,7 @@ bool controller::contains_local(const vec3d<int> rel_pos) const noexcept
 controller::iterator controller::find(const vec3d<int> pos) noexcept
 {
 	if(contains(pos))
-		return iterator(_chunks_map.data()+_chunks_map.size(), _chunks_map.data()+index_chunk(pos));
+		return iterator(&_chunks, _chunks_map.data()+_chunks_map.size(), _chunks_map.data()+index_chunk(pos));
 	else
 		return end();
 }
@@ -368,14 +773,14 @@ controller::iterator controller::find(const vec3d<int> pos) noexcept
 controller::const_iterator controller::find(const vec3d<int> pos) const noexcept
 {
 	if(contains(pos))
-		return const_iterator(_chunks_map.data()+_chunks_map.size(), _chunks_map.data()+index_chunk(pos));
+		return const_iterator(&_chunks, _chunks_map.data()+_chunks_map.size(), _chunks_map.data()+index_chunk(pos));
 	else
 		return cend();
 }
 
 controller::iterator controller::begin() noexcept
 {
-	iterator c_iter{_chunks_map.data()+_chunks_map.size(), _chunks_map.data()};
+	iterator c_iter{&_chunks, _chunks_map.data()+_chunks_map.size(), _chunks_map.data()};
 	if(exists(0))
 		return c_iter;
 	else
@@ -384,7 +789,7 @@ controller::iterator controller::begin() noexcept
 
 controller::const_iterator controller::cbegin() const noexcept
 {
-	const_iterator c_iter{_chunks_map.data()+_chunks_map.size(), _chunks_map.data()};
+	const_iterator c_iter{&_chunks, _chunks_map.data()+_chunks_map.size(), _chunks_map.data()};
 	if(exists(0))
 		return c_iter;
 	else
@@ -398,12 +803,12 @@ controller::const_iterator controller::begin() const noexcept
 
 controller::iterator controller::end() noexcept
 {
-	return iterator(_chunks_map.data()+_chunks_map.size(), _chunks_map.data()+_chunks_map.size());
+	return iterator(&_chunks, _chunks_map.data()+_chunks_map.size(), _chunks_map.data()+_chunks_map.size());
 }
 
 controller::const_iterator controller::cend() const noexcept
 {
-	return const_iterator(_chunks_map.data()+_chunks_map.size(), _chunks_map.data()+_chunks_map.size());
+	return const_iterator(&_chunks, _chunks_map.data()+_chunks_map.size(), _chunks_map.data()+_chunks_map.size());
 }
 
 controller::const_iterator controller::end() const noexcept
@@ -413,178 +818,263 @@ controller::const_iterator controller::end() const noexcept
 
 void controller::clear() noexcept
 {
-	_chunks_map = std::vector<full_chunk*>(_chunks_amount, nullptr);
+	_chunks_map = handle_container_type(_chunks_amount);
 	_status_flags = std::vector<bool>(_chunks_amount, false);
 	_chunks.clear();
 }
 
 void controller::connect_processed() noexcept
 {
-	std::lock_guard lock(_chunks.chunk_gen_mtx);
+	handle_container_type processed;
 
-	for(const auto chunk : _chunks.processed_chunks)
 	{
+		std::lock_guard lock(_chunks.chunk_gen_mtx);
+		processed.swap(_chunks.processed_chunks);
+	}
+
+	for(const auto handle : processed)
+	{
+		full_chunk* chunk = _chunks.get(handle);
+		if(chunk==nullptr)
+			continue;
+
 		const vec3d<int>& c_pos = chunk->chunk.position();
-		_chunks_map[index_chunk(c_pos)] = chunk;
-		chunk->chunk.connect_observer(this);
-		update_walls(c_pos, world_types::wall_states{});
+
+		//generated for a center thats gone by now, its slot belongs to another position
+		if(!in_bounds(c_pos) || exists(c_pos))
+		{
+			_chunks.remove_chunk(handle);
+			continue;
+		}
+
+		_chunks_map[index_chunk(c_pos)] = handle;
+		chunk->chunk.set_dirty_set(&_dirty_chunks);
+		chunk->model.reset(c_pos);
+
+		_remesh_chunks.push_back(c_pos);
+
+		//neighbours meshed before this chunk was loaded treated it as opaque
+		for(const auto side : {ytype::direction::left, ytype::direction::right, ytype::direction::forward,
+			ytype::direction::back, ytype::direction::down, ytype::direction::up})
+		{
+			const vec3d<int> side_pos = c_pos+direction_offset(side);
+			if(!contains(side_pos))
+				continue;
+
+			const full_chunk& side_chunk = at(side_pos);
+			if(side_chunk.chunk.empty() || side_chunk.chunk.check_empty())
+				continue;
+
+			if(side_chunk.model.missing_neighbours().side(direction_opposite(side)))
+				_remesh_chunks.push_back(side_pos);
+		}
 	}
+}
+
+void controller::place_generated() noexcept
+{
+	if(_generator==nullptr)
+		return;
+
+	for(const auto& [c_pos, blocks] : _generator->take_placed())
+	{
+		//out of range chunks get generated from scratch again anyway
+		if(!in_bounds(c_pos))
+			continue;
+
+		if(!contains(c_pos))
+		{
+			_generator->place_in_chunk(c_pos, blocks);
+			continue;
+		}
+
+		world_chunk& c_chunk = at(c_pos).chunk;
+		c_chunk.set_empty(false);
 
-	_chunks.processed_chunks.clear();
+		for(const auto& placed : blocks)
+			c_chunk.set_block(placed.block, placed.pos);
+	}
 }
 
 void controller::generate_missing()
 {
-	for(int i = 0; i < _chunks_amount; ++i)
+	std::vector<int> slots(_chunks_amount);
+	std::iota(slots.begin(), slots.end(), 0);
+
+	generate_missing(slots);
+}
+
+void controller::generate_missing(const std::vector<int>& slots)
+{
+	std::vector<vec3d<int>> positions;
+	positions.reserve(slots.size());
+
+	for(const int index : slots)
 	{
-		if(!_status_flags[i] && !exists(i))
+		if(!_status_flags[index] && !exists(index))
 		{
-			_status_flags[i] = true;
-			_chunk_gen_pool->run(index_position(i));
+			_status_flags[index] = true;
+			positions.push_back(index_position(index));
 		}
 	}
+
+	//queued all at once so the threads start with the nearest ones
+	_generator_workers->run(positions);
 }
 
-bool controller::reassign_chunks(const vec3d<int> pos) noexcept
+std::vector<int> controller::reassign_chunks(const vec3d<int> pos) noexcept
 {
+	std::vector<int> freed_slots;
+
 	if(_center_pos==pos)
-		return false;
+		return freed_slots;
 
-	_chunk_gen_pool->exit_threads();
+	//chunks still being generated for the old range get dropped once they arrive
+	_generator_workers->update_center(pos);
 
-	const bool overlap = squares_overlap(pos);
+	const vec3d<int> offset = pos-_center_pos;
 
-	if(overlap)
+	if(std::abs(offset.x)>=_row_size.x || std::abs(offset.y)>=_row_size.y || std::abs(offset.z)>=_row_size.z)
 	{
-		//move all chunks in the opposite direction
-		const vec3d<int> offset_pos = difference(pos) * vec3d<int>{-1, -1, -1};
+		clear();
 
-		for(int x_i = 0; x_i < _row_size; ++x_i)
+		freed_slots.resize(_chunks_amount);
+		std::iota(freed_slots.begin(), freed_slots.end(), 0);
+	} else
+	{
+		//slots wrap around, every chunk still in range keeps its slot and only the slabs that left the range get freed
+		const vec3d<int> start = _center_pos-_render_size;
+		const vec3d<int> end = _center_pos+_render_size;
+
+		for(int x = start.x; x <= end.x; ++x)
 		{
-			const int x = offset_pos.x<0 ? x_i : _row_size-1-x_i;
-			for(int y_i = 0; y_i < _row_size; ++y_i)
+			for(int y = start.y; y <= end.y; ++y)
 			{
-				const int y = offset_pos.y<0 ? y_i : _row_size-1-y_i;
-				for(int z_i = 0; z_i < _row_size; ++z_i)
+				if(std::abs(x-pos.x)>_render_size.x || std::abs(y-pos.y)>_render_size.y)
+				{
+					for(int z = start.z; z <= end.z; ++z)
+						release_slot({x, y, z}, freed_slots);
+				} else
 				{
-					const int z = offset_pos.z<0 ? z_i : _row_size-1-z_i;
-					move_chunk({x, y, z}, offset_pos);
+					const int z_start = offset.z>0 ? start.z : pos.z+_render_size.z+1;
+					const int z_end = offset.z>0 ? pos.z-_render_size.z : end.z+1;
+
+					for(int z = z_start; z < z_end; ++z)
+						release_slot({x, y, z}, freed_slots);
 				}
 			}
 		}
-	} else
-	{
-		clear();
 	}
 
-	generate_pool();
-
-	return true;
+	return freed_slots;
 }
 
-bool controller::squares_overlap(const vec3d<int> p2) const noexcept
+void controller::release_slot(const vec3d<int> pos, std::vector<int>& freed_slots) noexcept
 {
-	const vec3d<int>& p1 = _center_pos;
-	const int& length = _row_size;
-
-	const vec3d<int> p1_l{p1.x+length, p1.y+length, p1.z+length};
-	const vec3d<int> p2_l{p2.x+length, p2.y+length, p2.z+length};
-
-	if((p1.x>p2.x && p1_l.x<p2_l.x)
-		|| (p1.y>p2.y && p1_l.y<p2_l.y)
-		|| (p1.z>p2.z && p1_l.z<p2_l.z))
-		return false;
-	return true;
-}
+	const int index = index_chunk(pos);
 
-void controller::move_chunk(const vec3d<int> rel_pos, const vec3d<int> offset) noexcept
-{
-	const int c_index = index_local_chunk(rel_pos);
-	const vec3d<int> move_pos = rel_pos+offset;
+	//stale handles are ignored by the storage
+	_chunks.remove_chunk(_chunks_map[index]);
 
-	if(in_local_bounds(move_pos))
-	{
-		const int move_index = index_local_chunk(move_pos);
-		_chunks_map[move_index] = _chunks_map[c_index];
-		_status_flags[move_index] = true;
-	} else
-	{
-		_chunks.remove_chunk(*_chunks_map[c_index]);
-	}
+	_chunks_map[index] = chunk_handle{};
+	_status_flags[index] = false;
 
-	_chunks_map[c_index] = nullptr;
-	_status_flags[c_index] = false;
+	freed_slots.push_back(index);
 }
 
-void controller::update_chunks(const vec3d<int> pos, const world_types::wall_states chunks) noexcept
+void controller::queue_chunks(const vec3d<int> pos, const world_types::wall_states chunks) noexcept
 {
 	if(chunks.right)
-		update_chunk({pos.x+1, pos.y, pos.z});
+		_remesh_chunks.push_back({pos.x+1, pos.y, pos.z});
 
 	if(chunks.left)
-		update_chunk({pos.x-1, pos.y, pos.z});
+		_remesh_chunks.push_back({pos.x-1, pos.y, pos.z});
 
 	if(chunks.up)
-		update_chunk({pos.x, pos.y+1, pos.z});
+		_remesh_chunks.push_back({pos.x, pos.y+1, pos.z});
 
 	if(chunks.down)
-		update_chunk({pos.x, pos.y-1, pos.z});
+		_remesh_chunks.push_back({pos.x, pos.y-1, pos.z});
 
 	if(chunks.forward)
-		update_chunk({pos.x, pos.y, pos.z+1});
+		_remesh_chunks.push_back({pos.x, pos.y, pos.z+1});
 
 	if(chunks.back)
-		update_chunk({pos.x, pos.y, pos.z-1});
+		_remesh_chunks.push_back({pos.x, pos.y, pos.z-1});
 }
 
-void controller::update_chunk(const vec3d<int> pos) noexcept
+void controller::remesh_chunks() noexcept
 {
-	if(contains(pos))
+	for(auto* chunks : {&_remesh_chunks, &_edited_chunks})
 	{
-		at(pos).model.update_mesh();
-		update_walls(pos, world_types::wall_states{});
+		std::sort(chunks->begin(), chunks->end());
+		chunks->erase(std::unique(chunks->begin(), chunks->end()), chunks->end());
 	}
-}
 
-void controller::update_walls(const vec3d<int> pos, const world_types::wall_states walls) noexcept
-{
-	if(walls.right)
-		update_wall(pos, ytype::direction::right);
+	const auto remesh = [this](const vec3d<int> pos, const remesh_type type)
+	{
+		if(!contains(pos))
+			return;
 
-	if(walls.left)
-		update_wall(pos, ytype::direction::left);
+		//only one job per chunk, so an older mesh never replaces a newer one
+		const auto meshing = _meshing_chunks.find(pos);
+		if(meshing!=_meshing_chunks.end())
+		{
+			meshing->second = std::max(meshing->second, type);
+			return;
+		}
 
-	if(walls.up)
-		update_wall(pos, ytype::direction::up);
+		remesh_chunk(pos, type);
+	};
 
-	if(walls.down)
-		update_wall(pos, ytype::direction::down);
+	for(const auto& pos : _remesh_chunks)
+		remesh(pos, remesh_type::full);
 
-	if(walls.forward)
-		update_wall(pos, ytype::direction::forward);
+	for(const auto& pos : _edited_chunks)
+	{
+		//a full remesh covers the edits too
+		if(!std::binary_search(_remesh_chunks.begin(), _remesh_chunks.end(), pos))
+			remesh(pos, remesh_type::edited);
+	}
 
-	if(walls.back)
-		update_wall(pos, ytype::direction::back);
+	_remesh_chunks.clear();
+	_edited_chunks.clear();
 }
 
-void controller::update_wall(const vec3d<int> pos, const ytype::direction wall) noexcept
+void controller::remesh_chunk(const vec3d<int> pos, const remesh_type type) noexcept
 {
-	const int index = index_chunk(pos);
-	if(in_bounds(pos) && exists(index))
+	world_chunk& c_chunk = at(pos).chunk;
+
+	//the new mesh covers every edit up to now
+	const std::uint64_t dirty_bricks = c_chunk.take_dirty_bricks();
+
+	if(c_chunk.empty() || c_chunk.check_empty())
 	{
-		const vec3d<int> side = pos+direction_offset(wall);
-		const int side_index = index_chunk(side);
-		if(in_bounds(side) && exists(side_index))
-		{
-			update_side(index, side_index, wall);
-			update_side(side_index, index, direction_opposite(wall));
-		}
+		//nothing to mesh, no need to copy anything
+		static const std::shared_ptr<const chunk_mesh> empty_mesh = std::make_shared<const chunk_mesh>();
+		at(pos).model.set_mesh(empty_mesh);
+		return;
 	}
-}
 
-void controller::update_side(const int index, const int side_index, const ytype::direction wall) noexcept
-{
-	_chunks_map[index]->model.update_wall(_chunks_map[side_index]->chunk, wall);
+	std::shared_ptr<remesh_job> job = std::make_shared<remesh_job>(padded_chunk(c_chunk, lod_scale(pos, _center_pos)));
+
+	if(type==remesh_type::edited)
+	{
+		job->base = at(pos).model.mesh();
+		job->dirty_bricks = dirty_bricks;
+	}
+
+	for(const auto side : {ytype::direction::left, ytype::direction::right, ytype::direction::forward,
+		ytype::direction::back, ytype::direction::down, ytype::direction::up})
+	{
+		const vec3d<int> side_pos = pos+direction_offset(side);
+
+		if(contains(side_pos))
+			job->chunk.set_neighbour(side, at(side_pos).chunk, lod_scale(side_pos, _center_pos));
+	}
+
+	_meshing_chunks[pos] = remesh_type::none;
+	_mesh_workers->run(job);
 }
 
 bool controller::exists(const vec3d<int> pos) const noexcept
@@ -599,36 +1089,43 @@ bool controller::exists_local(const vec3d<int> rel_pos) const noexcept
 
 bool controller::exists(const int index) const noexcept
 {
-	return _chunks_map[index]!=nullptr;
+	return _chunks.get(_chunks_map[index])!=nullptr;
 }
 
 int controller::index_chunk(const vec3d<int> pos) const noexcept
 {
-	return index_local_chunk(position_local(pos));
+	return wrap_row(pos.x, _row_size.x)
+		+ wrap_row(pos.y, _row_size.y)*_row_size.x
+		+ wrap_row(pos.z, _row_size.z)*_row_size.x*_row_size.y;
 }
 
 int controller::index_local_chunk(const vec3d<int> rel_pos) const noexcept
 {
-	return rel_pos.x + rel_pos.y*_row_size + rel_pos.z*_row_size*_row_size;
+	return index_chunk(position_global(rel_pos));
 }
 
 vec3d<int> controller::index_position(const int index) const noexcept
 {
-	return vec3d<int>{index%_row_size+_center_pos.x-_render_size,
-		(index/_row_size)%_row_size+_center_pos.y-_render_size,
-		index/(_row_size*_row_size)+_center_pos.z-_render_size};
+	const vec3d<int> start = position_global({0, 0, 0});
+
+	return vec3d<int>{start.x+wrap_row(index%_row_size.x-start.x, _row_size.x),
+		start.y+wrap_row((index/_row_size.x)%_row_size.y-start.y, _row_size.y),
+		start.z+wrap_row(index/(_row_size.x*_row_size.y)-start.z, _row_size.z)};
+}
+
+int controller::wrap_row(const int val, const int row_size) noexcept
+{
+	const int wrapped = val%row_size;
+
+	return wrapped<0 ? wrapped+row_size : wrapped;
 }
 
 vec3d<int> controller::position_global(const vec3d<int> rel_pos) const noexcept
 {
-	return {rel_pos.x-_render_size+_center_pos.x,
-		rel_pos.y-_render_size+_center_pos.y,
-		rel_pos.z-_render_size+_center_pos.z};
+	return rel_pos-_render_size+_center_pos;
 }
 
 vec3d<int> controller::position_local(const vec3d<int> pos) const noexcept
 {
-	return {(_render_size+pos.x-_center_pos.x),
-		(_render_size+pos.y-_center_pos.y),
-		(_render_size+pos.z-_center_pos.z)};
+	return _render_size+pos-_center_pos;
 }
\ No newline at end of file
@@ -2,18 +2,33 @@
 #define YAN_CMAP_H
 
 #include <iterator>
+#include <map>
+#include <thread>
+#include <condition_variable>
 
 #include <ythreads.h>
 
 #include "types.h"
 #include "cmodel.h"
+#include "cmesher.h"
 
 class world_generator;
 
 namespace cmap
 {
 	typedef std::vector<full_chunk> container_type;
-	typedef std::vector<full_chunk*> ref_container_type;
+
+	//slot of a chunk in the storage, the generation changes every time the slot gets freed
+	//so handles to a chunk that got removed never reach the chunk reusing its slot
+	struct chunk_handle
+	{
+		int index = -1;
+		std::uint32_t generation = 0;
+
+		bool operator==(const chunk_handle&) const = default;
+	};
+
+	typedef std::vector<chunk_handle> handle_container_type;
 
 
 	class controller;
@@ -22,22 +37,32 @@ namespace cmap
 	{
 	public:
 		storage();
-		storage(controller* owner, world_generator* generator, const int size);
+		storage(controller* owner, world_generator* generator, const graphics_state& graphics, const int size);
 
 		storage(const storage&);
 		storage(storage&&) noexcept;
 		storage& operator=(const storage&);
 		storage& operator=(storage&&) noexcept;
 
-		void generate_chunk(const vec3d<int> pos);
+		//generates into a free slot, the slots block storage is reused instead of allocated again
+		//waits until a slot frees up if theres none, false if the storage got closed meanwhile
+		bool generate_chunk(const vec3d<int> pos);
+
+		//wakes up and turns away the threads waiting for a slot
+		void close() noexcept;
+
+		//nullptr if the handle is stale, generations only change on the owners thread so this doesnt lock
+		full_chunk* get(const chunk_handle handle) noexcept;
+		const full_chunk* get(const chunk_handle handle) const noexcept;
 
-		void remove_chunk(container_type::iterator chunk);
-		void remove_chunk(full_chunk& chunk);
+		//stale handles are ignored
+		void remove_chunk(const chunk_handle handle);
 
+		//slots still being generated stay taken, they arrive in processed_chunks later
 		void clear() noexcept;
 
 		container_type chunks;
-		ref_container_type processed_chunks;
+		handle_container_type processed_chunks;
 
 		mutable std::mutex chunk_gen_mtx;
 
@@ -45,17 +70,104 @@ namespace cmap
 		void copy_members(const storage&);
 		void move_members(storage&&) noexcept;
 
-		void remove_chunk(full_chunk& chunk, const int index);
+		void remove_chunk(const int index);
 
 		int _chunks_amount;
 
 		std::vector<int> _open_spots;
+		std::condition_variable _open_spots_cv;
+		bool _closed = false;
+
+		std::vector<std::uint32_t> _generations;
+		std::vector<bool> _generating;
 
 		controller* _owner = nullptr;
 		world_generator* _generator = nullptr;
 	};
 
-	class controller : public chunk_observer
+	//long lived threads generating queued positions nearest to the center first, positions in view count as nearer
+	//moving the center drops queued positions that left the range instead of restarting the threads
+	class generator_workers
+	{
+	public:
+		generator_workers(storage* chunks, const int threads, const vec3d<int> render_size, const vec3d<int> center);
+		~generator_workers();
+
+		//the whole batch is queued before any thread picks from it
+		void run(const std::vector<vec3d<int>>& positions);
+
+		//cancels positions outside of the new range and reorders the rest
+		void update_center(const vec3d<int> center);
+		//direction has to be normalized
+		void update_view(const vec3d<float> direction);
+
+	private:
+		void work();
+
+		bool in_range(const vec3d<int> pos) const noexcept;
+		//true if lhs should be generated after rhs
+		bool later(const vec3d<int> lhs, const vec3d<int> rhs) const noexcept;
+		float priority(const vec3d<int> pos) const noexcept;
+
+		//how much closer a chunk right in front of the camera counts, in fractions of its distance
+		static constexpr float view_weight = 0.5f;
+		//the queue only gets reordered once the view turns further than this (cosine of the angle)
+		static constexpr float view_threshold = 0.95f;
+
+		storage* _chunks = nullptr;
+
+		vec3d<int> _render_size;
+		vec3d<int> _center;
+		vec3d<float> _view{0, 0, 0};
+
+		std::mutex _queue_mtx;
+		std::condition_variable _queue_cv;
+		//heap with the nearest position on top
+		std::vector<vec3d<int>> _queue;
+
+		bool _exit = false;
+
+		std::vector<std::thread> _threads;
+	};
+
+	//padded copy of a chunk, meshed on the mesh threads
+	struct remesh_job
+	{
+		padded_chunk chunk;
+
+		//last mesh of an edited chunk, only the slabs of the dirty bricks get meshed again on top of it
+		std::shared_ptr<const chunk_mesh> base;
+		std::uint64_t dirty_bricks = 0;
+
+		std::shared_ptr<const chunk_mesh> mesh;
+	};
+
+	class mesh_workers
+	{
+	public:
+		mesh_workers(const int threads);
+		~mesh_workers();
+
+		void run(const std::shared_ptr<remesh_job> job);
+
+		std::vector<std::shared_ptr<remesh_job>> take_finished();
+
+		mesh_cache::counters cache_counters() const noexcept;
+
+	private:
+		void build(const std::shared_ptr<remesh_job> job);
+
+		mesh_cache _cache;
+
+		std::mutex _finished_mtx;
+		std::vector<std::shared_ptr<remesh_job>> _finished;
+
+		typedef ythreads::pool<void (mesh_workers::*)(const std::shared_ptr<remesh_job>),
+			std::shared_ptr<remesh_job>, mesh_workers*> mesh_pool_type;
+		std::unique_ptr<mesh_pool_type> _mesh_pool;
+	};
+
+	class controller
 	{
 	public:
 		struct iterator
@@ -63,10 +175,10 @@ namespace cmap
 			using iterator_content = std::forward_iterator_tag;
 			using difference_type = std::ptrdiff_t;
 			using value_type = full_chunk*;
-			using pointer = value_type*;
+			using pointer = value_type;
 			using reference = full_chunk&;
 
-			iterator(const value_type* end, pointer p);
+			iterator(storage* chunks, const chunk_handle* end, const chunk_handle* p);
 
 			reference operator*() const;
 			value_type operator->();
@@ -78,8 +190,10 @@ namespace cmap
 			friend bool operator!=(const iterator& a, const iterator& b);
 
 		private:
-			pointer _ptr;
-			const value_type* _end_ptr;
+			storage* _chunks;
+
+			const chunk_handle* _ptr;
+			const chunk_handle* _end_ptr;
 		};
 
 		struct const_iterator
@@ -87,10 +201,10 @@ namespace cmap
 			using iterator_content = std::forward_iterator_tag;
 			using difference_type = std::ptrdiff_t;
 			using value_type = const full_chunk*;
-			using pointer = const value_type*;
+			using pointer = value_type;
 			using reference = const full_chunk&;
 
-			const_iterator(pointer end, pointer p);
+			const_iterator(const storage* chunks, const chunk_handle* end, const chunk_handle* p);
 
 			reference operator*() const;
 			value_type operator->() const;
@@ -102,20 +216,39 @@ namespace cmap
 			friend bool operator!=(const const_iterator& a, const const_iterator& b);
 
 		private:
-			pointer _ptr;
-			pointer _end_ptr;
+			const storage* _chunks;
+
+			const chunk_handle* _ptr;
+			const chunk_handle* _end_ptr;
 		};
 
 		controller();
-		controller(world_generator* generator, const int render_size, const vec3d<int> center_pos);
+		//chunks are loaded in a box, render_size chunks around the center horizontally and vertical_size vertically
+		controller(world_generator* generator, const graphics_state& graphics,
+			const int render_size, const int vertical_size, const vec3d<int> center_pos);
 
 		controller(const controller&);
 		controller& operator=(const controller&&);
 
+		//chunks this far away from the center get meshed at half resolution, twice as far at a quarter
+		static constexpr int lod_distance = 4;
+
 		void update() noexcept;
 		void update_center(const vec3d<int> pos);
+		//chunks in front of the camera get generated first
+		void update_view(const vec3d<float> direction);
+
+		//queues a remesh of every chunk edited since the last call and its touched neighbours once
+		void update_dirty() noexcept;
+		//swaps in meshes finished by the mesh threads
+		void update_meshes() noexcept;
 
-		void block_notify(const vec3d<int> chunk, const vec3d<int> pos);
+		//chunks that reused the mesh of another chunk with the same contents
+		mesh_cache::counters mesh_cache_counters() const noexcept;
+
+		//edited chunks are only remeshed after the last batch is committed
+		void begin_edit() noexcept;
+		void commit_edit() noexcept;
 
 		full_chunk& at(const vec3d<int> pos);
 		const full_chunk& at(const vec3d<int> pos) const;
@@ -141,50 +274,82 @@ namespace cmap
 
 	private:
 		void connect_processed() noexcept;
+		//applies the blocks generated structures placed into other chunks, keeps the ones for chunks that arent loaded yet
+		void place_generated() noexcept;
 
 		void generate_missing();
+		void generate_missing(const std::vector<int>& slots);
 
-		bool reassign_chunks(const vec3d<int> pos) noexcept;
-		bool squares_overlap(const vec3d<int> pos) const noexcept;
+		//frees the slots of chunks that leave the range, returns them
+		std::vector<int> reassign_chunks(const vec3d<int> pos) noexcept;
+		void release_slot(const vec3d<int> pos, std::vector<int>& freed_slots) noexcept;
 
-		void move_chunk(const vec3d<int> rel_pos, const vec3d<int> offset) noexcept;
+		//edited chunks only need the slabs of their dirty bricks meshed again, a full remesh always wins
+		enum class remesh_type
+		{
+			none,
+			edited,
+			full
+		};
 
-		void update_chunks(const vec3d<int> pos, const world_types::wall_states chunks) noexcept;
-		void update_chunk(const vec3d<int> pos) noexcept;
+		void queue_chunks(const vec3d<int> pos, const world_types::wall_states chunks) noexcept;
 
-		void update_walls(const vec3d<int> pos, const world_types::wall_states walls) noexcept;
-		void update_wall(const vec3d<int> pos, const ytype::direction wall) noexcept;
-		void update_side(const int index, const int side_index, const ytype::direction wall) noexcept;
+		void remesh_chunks() noexcept;
+		void remesh_chunk(const vec3d<int> pos, const remesh_type type) noexcept;
+
+		//remeshes chunks that changed lod since the center moved
+		void update_lods(const vec3d<int> old_center) noexcept;
+		static int lod_scale(const vec3d<int> pos, const vec3d<int> center) noexcept;
 
 		bool exists(const vec3d<int> pos) const noexcept;
 		bool exists_local(const vec3d<int> rel_pos) const noexcept;
 		bool exists(const int index) const noexcept;
 
+		//chunks are indexed by their position wrapped around the row size, so they never move when the center does
 		int index_chunk(const vec3d<int> pos) const noexcept;
 		int index_local_chunk(const vec3d<int> rel_pos) const noexcept;
 		vec3d<int> index_position(const int index) const noexcept;
 
+		static int wrap_row(const int val, const int row_size) noexcept;
+
 		vec3d<int> position_global(const vec3d<int> rel_pos) const noexcept;
 		vec3d<int> position_local(const vec3d<int> pos) const noexcept;
 
 		void generate_all() noexcept;
 		void generate_pool() noexcept;
+		void generate_mesh_pool() noexcept;
+
+		//the storage gets a spot per thread on top of the range
+		//generated chunks keep their spot until connect_processed takes them in or drops them as stale
+		//so the spots can still run out, the threads wait for one to free up then
+		static int generator_threads() noexcept;
 
 		vec3d<int> _center_pos;
 
-		int _render_size;
-		int _row_size;
+		//per axis, the vertical one can be smaller since terrain only spans a few chunks
+		vec3d<int> _render_size;
+		vec3d<int> _row_size;
 		int _chunks_amount;
 
 		world_generator* _generator = nullptr;
+		graphics_state _graphics;
 
 		storage _chunks;
-		std::vector<full_chunk*> _chunks_map;
+		//handles of the chunk at each wrapped position, stale ones count as missing
+		handle_container_type _chunks_map;
 		std::vector<bool> _status_flags;
 
-		typedef ythreads::pool<void (storage::*)(const vec3d<int>),
-			vec3d<int>, storage*> cgen_pool_type;
-		std::unique_ptr<cgen_pool_type> _chunk_gen_pool;
+		int _edit_depth = 0;
+
+		dirty_chunks _dirty_chunks;
+		std::vector<vec3d<int>> _remesh_chunks;
+		std::vector<vec3d<int>> _edited_chunks;
+
+		//chunks with a mesh job running, with the remesh they got queued for again meanwhile
+		std::map<vec3d<int>, remesh_type> _meshing_chunks;
+		std::unique_ptr<mesh_workers> _mesh_workers;
+
+		std::unique_ptr<generator_workers> _generator_workers;
 	};
 };
 
@@ -0,0 +1,740 @@
+#include <bit>
+#include <algorithm>
+#include <cassert>
+
+#include "cmesher.h"
+
+using namespace world_types;
+
+
+size_t mesh_key::hasher::operator()(const mesh_key& key) const noexcept
+{
+	std::uint64_t hash = ytype::hash_combine(key.block.id, key.scale);
+
+	for(int i = 0; i < 6; ++i)
+	{
+		hash = ytype::hash_combine(hash, key.loaded[i]);
+
+		for(const auto& block : key.borders[i])
+			hash = ytype::hash_combine(hash, block.id);
+	}
+
+	return hash;
+}
+
+
+padded_chunk::padded_chunk(const world_chunk& chunk, const int scale)
+: _chunk(chunk), _scale(scale), _size(chunk_size/scale)
+{
+	assert(world_chunk::brick_size%scale==0);
+
+	for(auto& c_border : _borders)
+		c_border.fill(world_block{block::stone});
+}
+
+void padded_chunk::set_neighbour(const ytype::direction side, const world_chunk& neighbour, const int neighbour_scale) noexcept
+{
+	const int side_index = static_cast<int>(side)-1;
+
+	const vec3d<int> offset = ytype::direction_offset(side)*chunk_size;
+
+	//a cell touches more than one cell of a finer neighbour
+	const int step = std::min(_scale, neighbour_scale);
+
+	for(int a = 0; a < _size; ++a)
+	{
+		for(int b = 0; b < _size; ++b)
+		{
+			//the layer on the opposite wall of the neighbour
+			const auto neighbour_block = [&](const int i, const int j)
+			{
+				return scaled_block(neighbour, border_position(side, a*_scale+i, b*_scale+j)-offset, neighbour_scale);
+			};
+
+			world_block visible = neighbour_block(0, 0);
+
+			for(int i = 0; i < _scale; i += step)
+			{
+				for(int j = 0; j < _scale; j += step)
+				{
+					const world_block c_block = neighbour_block(i, j);
+
+					if(visibility(c_block)>visibility(visible))
+						visible = c_block;
+				}
+			}
+
+			_borders[side_index][a*_size+b] = visible;
+		}
+	}
+
+	_loaded[side_index] = true;
+}
+
+void padded_chunk::downsample() noexcept
+{
+	if(_scale==1 || !_cells.empty())
+		return;
+
+	_cells.resize(_size*_size*_size);
+	_solid_columns.assign(_size*_size, 0);
+	_transparent_columns.assign(_size*_size, 0);
+
+	for(int x = 0; x < _size; ++x)
+	{
+		for(int y = 0; y < _size; ++y)
+		{
+			for(int z = 0; z < _size; ++z)
+			{
+				const world_block c_block = _chunk.cell_block({x, y, z}, _scale);
+				_cells[index_cell({x, y, z})] = c_block;
+
+				if(!c_block.solid())
+					continue;
+
+				_solid_columns[x*_size+z] |= std::uint32_t(1)<<y;
+
+				if(c_block.transparent())
+					_transparent_columns[x*_size+z] |= std::uint32_t(1)<<y;
+			}
+		}
+	}
+}
+
+world_block padded_chunk::block(const vec3d<int> pos) const noexcept
+{
+	if(pos.x>=0 && pos.y>=0 && pos.z>=0 && pos.x<_size && pos.y<_size && pos.z<_size)
+		return _scale==1 ? _chunk.block(pos) : _cells[index_cell(pos)];
+
+	if(pos.x<0)
+		return _borders[static_cast<int>(ytype::direction::left)-1][pos.y*_size+pos.z];
+	else if(pos.x>=_size)
+		return _borders[static_cast<int>(ytype::direction::right)-1][pos.y*_size+pos.z];
+	else if(pos.y<0)
+		return _borders[static_cast<int>(ytype::direction::down)-1][pos.x*_size+pos.z];
+	else if(pos.y>=_size)
+		return _borders[static_cast<int>(ytype::direction::up)-1][pos.x*_size+pos.z];
+	else if(pos.z<0)
+		return _borders[static_cast<int>(ytype::direction::back)-1][pos.x*_size+pos.y];
+	else
+		return _borders[static_cast<int>(ytype::direction::forward)-1][pos.x*_size+pos.y];
+}
+
+std::uint32_t padded_chunk::solid_column(const int x, const int z) const noexcept
+{
+	return _scale==1 ? _chunk.solid_column(x, z) : _solid_columns[x*_size+z];
+}
+
+std::uint32_t padded_chunk::transparent_column(const int x, const int z) const noexcept
+{
+	return _scale==1 ? _chunk.transparent_column(x, z) : _transparent_columns[x*_size+z];
+}
+
+const world_chunk& padded_chunk::chunk() const noexcept
+{
+	return _chunk;
+}
+
+int padded_chunk::scale() const noexcept
+{
+	return _scale;
+}
+
+int padded_chunk::size() const noexcept
+{
+	return _size;
+}
+
+wall_states padded_chunk::missing() const noexcept
+{
+	const auto missing_side = [this](const ytype::direction side){return !_loaded[static_cast<int>(side)-1];};
+
+	return wall_states{missing_side(ytype::direction::right), missing_side(ytype::direction::left),
+		missing_side(ytype::direction::up), missing_side(ytype::direction::down),
+		missing_side(ytype::direction::forward), missing_side(ytype::direction::back)};
+}
+
+std::optional<mesh_key> padded_chunk::cache_key() const
+{
+	if(!_chunk.uniform())
+		return std::nullopt;
+
+	mesh_key key{_chunk.uniform_block(), _scale, _loaded, {}};
+
+	for(int i = 0; i < 6; ++i)
+	{
+		const auto start = _borders[i].begin();
+		const auto end = start+_size*_size;
+
+		if(std::all_of(start, end, [start](const world_block block){return block==*start;}))
+			key.borders[i].assign(1, *start);
+		else
+			key.borders[i].assign(start, end);
+	}
+
+	return key;
+}
+
+vec3d<int> padded_chunk::border_position(const ytype::direction side, const int a, const int b) noexcept
+{
+	switch(side)
+	{
+		default:
+		case ytype::direction::left:
+			return {-1, a, b};
+
+		case ytype::direction::right:
+			return {chunk_size, a, b};
+
+		case ytype::direction::down:
+			return {a, -1, b};
+
+		case ytype::direction::up:
+			return {a, chunk_size, b};
+
+		case ytype::direction::back:
+			return {a, b, -1};
+
+		case ytype::direction::forward:
+			return {a, b, chunk_size};
+	}
+}
+
+world_block padded_chunk::scaled_block(const world_chunk& chunk, const vec3d<int> pos, const int scale) noexcept
+{
+	if(scale==1)
+		return chunk.block(pos);
+
+	return chunk.cell_block(pos/scale, scale);
+}
+
+int padded_chunk::visibility(const world_block block) noexcept
+{
+	if(!block.solid())
+		return 2;
+
+	return block.transparent() ? 1 : 0;
+}
+
+int padded_chunk::index_cell(const vec3d<int> pos) const noexcept
+{
+	return (pos.x*_size+pos.y)*_size+pos.z;
+}
+
+
+mesh_cache::mesh_cache()
+{
+}
+
+std::shared_ptr<const chunk_mesh> mesh_cache::find(const mesh_key& key) noexcept
+{
+	std::lock_guard lock(_mtx);
+
+	const auto found = _meshes.find(key);
+	if(found!=_meshes.end())
+	{
+		std::shared_ptr<const chunk_mesh> mesh = found->second.lock();
+		if(mesh)
+		{
+			++_counters.hits;
+			return mesh;
+		}
+	}
+
+	++_counters.misses;
+	return nullptr;
+}
+
+void mesh_cache::insert(const mesh_key& key, const std::shared_ptr<const chunk_mesh> mesh)
+{
+	std::lock_guard lock(_mtx);
+
+	_meshes[key] = mesh;
+
+	if(_meshes.size()>_prune_size)
+		remove_unused();
+}
+
+mesh_cache::counters mesh_cache::cache_counters() const noexcept
+{
+	std::lock_guard lock(_mtx);
+
+	return _counters;
+}
+
+void mesh_cache::remove_unused() noexcept
+{
+	std::erase_if(_meshes, [](const auto& entry){return entry.second.expired();});
+
+	_prune_size = std::max(min_prune_size, _meshes.size()*2);
+}
+
+
+chunk_mesher::chunk_mesher(const padded_chunk& padded, chunk_mesh& mesh)
+: _padded(padded), _chunk(padded.chunk()), _mesh(mesh),
+_size(padded.size()), _scale(padded.scale())
+{
+}
+
+void chunk_mesher::build() noexcept
+{
+	const std::uint32_t all_slabs = (std::uint32_t(1)<<world_chunk::bricks_side)-1;
+
+	build(nullptr, {all_slabs, all_slabs, all_slabs});
+}
+
+void chunk_mesher::rebuild(const chunk_mesh& old_mesh, const std::uint64_t dirty_bricks) noexcept
+{
+	if(old_mesh.scale!=_scale)
+	{
+		build();
+		return;
+	}
+
+	std::array<std::uint32_t, 3> slabs{0, 0, 0};
+
+	for(int x = 0; x < world_chunk::bricks_side; ++x)
+	{
+		for(int y = 0; y < world_chunk::bricks_side; ++y)
+		{
+			for(int z = 0; z < world_chunk::bricks_side; ++z)
+			{
+				if(((dirty_bricks>>world_chunk::index_brick({x, y, z})) & 1)==0)
+					continue;
+
+				slabs[0] |= std::uint32_t(1)<<x;
+				slabs[1] |= std::uint32_t(1)<<y;
+				slabs[2] |= std::uint32_t(1)<<z;
+			}
+		}
+	}
+
+	//edits only mark the bricks of the blocks next to them, on lods the next cell can be a brick over
+	if(_scale>1)
+	{
+		const std::uint32_t all_slabs = (std::uint32_t(1)<<world_chunk::bricks_side)-1;
+
+		for(auto& axis_slabs : slabs)
+			axis_slabs = (axis_slabs | (axis_slabs<<1) | (axis_slabs>>1)) & all_slabs;
+	}
+
+	build(&old_mesh, slabs);
+}
+
+void chunk_mesher::build(const chunk_mesh* old_mesh, const std::array<std::uint32_t, 3> slabs) noexcept
+{
+	for(auto& vertices : _mesh.opaque)
+		vertices.clear();
+
+	_mesh.transparent.clear();
+
+	_mesh.opaque_slabs = {};
+	_mesh.transparent_slabs = {};
+
+	_mesh.scale = _scale;
+	_mesh.missing = _padded.missing();
+
+	if(_chunk.empty())
+		return;
+
+	if(_chunk.check_empty())
+		return;
+
+	//every inside face touches either an opaque block or the same block, only the walls can be visible
+	const bool walls_only = _chunk.check_opaque() || _chunk.uniform();
+		
+	//bricks of the chunk still line up with the cells of a lod
+	const int brick_size = world_chunk::brick_size/_scale;
+
+	//the top and bottom rows touch the neighbours so they can always be visible
+	const std::uint32_t wall_rows = 1 | (std::uint32_t(1)<<(_size-1));
+
+	chunk_faces faces{};
+
+	for(int brick_x = 0; brick_x < world_chunk::bricks_side; ++brick_x)
+	{
+		for(int brick_z = 0; brick_z < world_chunk::bricks_side; ++brick_z)
+		{
+			//blocks in buried bricks cant have any visible faces
+			std::uint32_t hidden_rows = 0;
+			bool brick_empty = true;
+
+			for(int brick_y = 0; brick_y < world_chunk::bricks_side; ++brick_y)
+			{
+				const vec3d<int> brick{brick_x, brick_y, brick_z};
+
+				brick_empty = brick_empty && _chunk.brick_empty(brick);
+
+				if(walls_only || _chunk.brick_buried(brick))
+					hidden_rows |= ((std::uint32_t(1)<<brick_size)-1)<<(brick_y*brick_size);
+			}
+
+			if(brick_empty)
+				continue;
+
+			hidden_rows &= ~wall_rows;
+
+			for(int x = brick_x*brick_size; x < (brick_x+1)*brick_size; ++x)
+			{
+				for(int z = brick_z*brick_size; z < (brick_z+1)*brick_size; ++z)
+				{
+					const bool wall_column = x==0 || z==0 || x==_size-1 || z==_size-1;
+
+					if((_padded.solid_column(x, z) & ~(wall_column ? 0 : hidden_rows))!=0)
+						update_column_walls(x, z, faces);
+				}
+			}
+		}
+	}
+
+	for(const auto side : {ytype::direction::left, ytype::direction::right, ytype::direction::forward,
+		ytype::direction::back, ytype::direction::down, ytype::direction::up})
+	{
+		const int index = side_index(side);
+
+		for(int slab = 0; slab < world_chunk::bricks_side; ++slab)
+		{
+			_mesh.opaque_slabs[index][slab] = _mesh.opaque[index].size();
+			_mesh.transparent_slabs[index][slab] = _mesh.transparent.size();
+
+			if(old_mesh==nullptr || ((slabs[side_axis(side)]>>slab) & 1)!=0)
+				add_slab(side, slab, faces);
+			else
+				copy_slab(side, slab, *old_mesh);
+		}
+
+		_mesh.opaque_slabs[index][world_chunk::bricks_side] = _mesh.opaque[index].size();
+		_mesh.transparent_slabs[index][world_chunk::bricks_side] = _mesh.transparent.size();
+	}
+}
+
+void chunk_mesher::add_slab(const ytype::direction side, const int slab, const chunk_faces& faces) noexcept
+{
+	//bricks still line up with the cells of a lod
+	const int slab_size = world_chunk::brick_size/_scale;
+
+	for(int slice = slab*slab_size; slice < (slab+1)*slab_size; ++slice)
+		add_slice(side, slice, faces[side_index(side)][slice]);
+}
+
+void chunk_mesher::copy_slab(const ytype::direction side, const int slab, const chunk_mesh& old_mesh) noexcept
+{
+	const int index = side_index(side);
+
+	const auto copy_range = [slab](std::vector<std::uint32_t>& vertices, const std::vector<std::uint32_t>& old_vertices,
+		const std::array<std::uint32_t, world_chunk::bricks_side+1>& offsets)
+	{
+		vertices.insert(vertices.end(), old_vertices.begin()+offsets[slab], old_vertices.begin()+offsets[slab+1]);
+	};
+
+	copy_range(_mesh.opaque[index], old_mesh.opaque[index], old_mesh.opaque_slabs[index]);
+	copy_range(_mesh.transparent, old_mesh.transparent, old_mesh.transparent_slabs[index]);
+}
+
+chunk_mesher::column_masks chunk_mesher::column(const int x, const int z) const noexcept
+{
+	if(x<0 || z<0 || x>=_size || z>=_size)
+	{
+		//column of a neighbours border
+		column_masks masks{0, 0, 0};
+
+		for(int y = 0; y < _size; ++y)
+		{
+			const column_masks c_masks = block_masks(_padded.block({x, y, z}), y);
+
+			masks.opaque |= c_masks.opaque;
+			masks.transparent |= c_masks.transparent;
+			masks.air |= c_masks.air;
+		}
+
+		return masks;
+	}
+
+	const std::uint32_t solid = _padded.solid_column(x, z);
+	const std::uint32_t transparent = _padded.transparent_column(x, z);
+
+	//lods have less cells than bits
+	const std::uint32_t cells = _size==32 ? ~std::uint32_t(0) : (std::uint32_t(1)<<_size)-1;
+
+	return column_masks{solid & ~transparent, transparent, ~solid & cells};
+}
+
+chunk_mesher::column_masks chunk_mesher::block_masks(const world_block block, const int y) noexcept
+{
+	const std::uint32_t bit = std::uint32_t(1)<<y;
+
+	if(!block.solid())
+		return column_masks{0, 0, bit};
+
+	if(block.transparent())
+		return column_masks{0, bit, 0};
+
+	return column_masks{bit, 0, 0};
+}
+
+std::uint32_t chunk_mesher::visible_faces(const column_masks& c_column, const column_masks& check,
+	const vec3d<int> pos, const vec3d<int> offset) const noexcept
+{
+	std::uint32_t visible = (c_column.opaque & ~check.opaque) | (c_column.transparent & check.air);
+
+	//transparent blocks touching other transparent blocks only show different types
+	std::uint32_t compare = c_column.transparent & check.transparent;
+	while(compare!=0)
+	{
+		const int y = std::countr_zero(compare);
+		compare &= compare-1;
+
+		const vec3d<int> c_pos{pos.x, y, pos.z};
+		if(draw_side(_padded.block(c_pos), _padded.block(c_pos+offset)))
+			visible |= std::uint32_t(1)<<y;
+	}
+
+	return visible;
+}
+
+void chunk_mesher::update_column_walls(const int x, const int z, chunk_faces& faces) const noexcept
+{
+	const column_masks c_column = column(x, z);
+
+	//the blocks above and below the column come from the up and down neighbours
+	const column_masks top = block_masks(_padded.block({x, _size, z}), _size-1);
+	const column_masks bottom = block_masks(_padded.block({x, -1, z}), 0);
+
+	const column_masks up_column{(c_column.opaque>>1) | top.opaque,
+		(c_column.transparent>>1) | top.transparent,
+		(c_column.air>>1) | top.air};
+
+	const column_masks down_column{(c_column.opaque<<1) | bottom.opaque,
+		(c_column.transparent<<1) | bottom.transparent,
+		(c_column.air<<1) | bottom.air};
+
+	const vec3d<int> pos{x, 0, z};
+
+	const std::uint32_t forward = visible_faces(c_column, column(x, z+1), pos, {0, 0, 1});
+	const std::uint32_t back = visible_faces(c_column, column(x, z-1), pos, {0, 0, -1});
+	const std::uint32_t up = visible_faces(c_column, up_column, pos, {0, 1, 0});
+	const std::uint32_t down = visible_faces(c_column, down_column, pos, {0, -1, 0});
+	const std::uint32_t right = visible_faces(c_column, column(x+1, z), pos, {1, 0, 0});
+	const std::uint32_t left = visible_faces(c_column, column(x-1, z), pos, {-1, 0, 0});
+
+	//scatter the column into the slices of every side
+	for(std::uint32_t mask = forward; mask!=0; mask &= mask-1)
+		faces[side_index(ytype::direction::forward)][z][std::countr_zero(mask)] |= std::uint32_t(1)<<x;
+
+	for(std::uint32_t mask = back; mask!=0; mask &= mask-1)
+		faces[side_index(ytype::direction::back)][z][std::countr_zero(mask)] |= std::uint32_t(1)<<x;
+
+	for(std::uint32_t mask = up; mask!=0; mask &= mask-1)
+		faces[side_index(ytype::direction::up)][std::countr_zero(mask)][z] |= std::uint32_t(1)<<x;
+
+	for(std::uint32_t mask = down; mask!=0; mask &= mask-1)
+		faces[side_index(ytype::direction::down)][std::countr_zero(mask)][z] |= std::uint32_t(1)<<x;
+
+	for(std::uint32_t mask = right; mask!=0; mask &= mask-1)
+		faces[side_index(ytype::direction::right)][x][std::countr_zero(mask)] |= std::uint32_t(1)<<z;
+
+	for(std::uint32_t mask = left; mask!=0; mask &= mask-1)
+		faces[side_index(ytype::direction::left)][x][std::countr_zero(mask)] |= std::uint32_t(1)<<z;
+}
+
+void chunk_mesher::add_slice(const ytype::direction side, const int slice, slice_faces faces) noexcept
+{
+	std::array<std::array<world_block, chunk_size>, chunk_size> blocks;
+
+	for(int row = 0; row < _size; ++row)
+	{
+		for(std::uint32_t mask = faces[row]; mask!=0; mask &= mask-1)
+		{
+			const int bit = std::countr_zero(mask);
+			blocks[row][bit] = _padded.block(slice_position(side, slice, row, bit));
+		}
+	}
+
+	for(int row = 0; row < _size; ++row)
+	{
+		while(faces[row]!=0)
+		{
+			const int start = std::countr_zero(faces[row]);
+			const world_block c_block = blocks[row][start];
+
+			int width = 1;
+			int height = 1;
+
+			if constexpr(greedy_mesh)
+			{
+				//grow along the row first, then grow the whole run over the next rows
+				while(start+width<_size && ((faces[row]>>(start+width)) & 1)!=0
+					&& merge_faces(c_block, blocks[row][start+width], side))
+					++width;
+			}
+
+			const std::uint32_t run = (width==chunk_size ? ~std::uint32_t(0) : (std::uint32_t(1)<<width)-1)<<start;
+
+			if constexpr(greedy_mesh)
+			{
+				bool grow = true;
+				while(grow && row+height<_size && (faces[row+height] & run)==run)
+				{
+					for(int bit = start; bit < start+width && grow; ++bit)
+						grow = merge_faces(c_block, blocks[row+height][bit], side);
+
+					if(grow)
+						++height;
+				}
+			}
+
+			for(int c_row = row; c_row < row+height; ++c_row)
+				faces[c_row] &= ~run;
+
+			add_face(side, slice_position(side, slice, row, start), width, height, c_block);
+		}
+	}
+}
+
+void chunk_mesher::add_face(const ytype::direction side, const vec3d<int> pos,
+	const int width, const int height, const world_block block) noexcept
+{
+	std::vector<std::uint32_t>& c_vertices = block.transparent() ? _mesh.transparent : _mesh.opaque[side_index(side)];
+
+	const tex_pos texture = block.texture().side(side);
+
+	//cells are scale blocks wide, the emitters put faces on the far side one block over
+	const vec3d<int> offset = ytype::direction_offset(side);
+	const vec3d<int> block_pos = pos*_scale + (offset.x+offset.y+offset.z>0 ? offset*(_scale-1) : vec3d<int>{0, 0, 0});
+
+	const int block_width = width*_scale;
+	const int block_height = height*_scale;
+
+	switch(side)
+	{
+		default:
+		case ytype::direction::forward:
+			a_forward_face(c_vertices, block_pos, block_width, block_height, texture);
+			break;
+
+		case ytype::direction::back:
+			a_back_face(c_vertices, block_pos, block_width, block_height, texture);
+			break;
+
+		case ytype::direction::up:
+			a_up_face(c_vertices, block_pos, block_width, block_height, texture);
+			break;
+
+		case ytype::direction::down:
+			a_down_face(c_vertices, block_pos, block_width, block_height, texture);
+			break;
+
+		case ytype::direction::right:
+			a_right_face(c_vertices, block_pos, block_width, block_height, texture);
+			break;
+
+		case ytype::direction::left:
+			a_left_face(c_vertices, block_pos, block_width, block_height, texture);
+			break;
+	}
+}
+
+int chunk_mesher::side_index(const ytype::direction side) noexcept
+{
+	return static_cast<int>(side)-1;
+}
+
+int chunk_mesher::side_axis(const ytype::direction side) noexcept
+{
+	switch(side)
+	{
+		default:
+		case ytype::direction::left:
+		case ytype::direction::right:
+			return 0;
+
+		case ytype::direction::down:
+		case ytype::direction::up:
+			return 1;
+
+		case ytype::direction::forward:
+		case ytype::direction::back:
+			return 2;
+	}
+}
+
+vec3d<int> chunk_mesher::slice_position(const ytype::direction side, const int slice, const int row, const int bit) noexcept
+{
+	switch(side)
+	{
+		default:
+		case ytype::direction::forward:
+		case ytype::direction::back:
+			return {bit, row, slice};
+
+		case ytype::direction::up:
+		case ytype::direction::down:
+			return {bit, slice, row};
+
+		case ytype::direction::right:
+		case ytype::direction::left:
+			return {slice, row, bit};
+	}
+}
+
+bool chunk_mesher::merge_faces(const world_block block, const world_block check, const ytype::direction side) noexcept
+{
+	if(block==check)
+		return true;
+
+	return block.transparent()==check.transparent() && block.texture().side(side)==check.texture().side(side);
+}
+
+bool chunk_mesher::draw_side(const world_block& block, const world_block& check) noexcept
+{
+	return check.transparent() && (block.type() != check.type());
+}
+
+void chunk_mesher::a_forward_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept
+{
+	//i cant write any better code for these, it literally HAS to be hardcoded :/
+	vertices.insert(vertices.end(), {chunk_vertex::pack({{pos.x, pos.y, pos.z+1}, ytype::direction::forward, texture_pos}),
+		chunk_vertex::pack({{pos.x+width, pos.y, pos.z+1}, ytype::direction::forward, texture_pos}),
+		chunk_vertex::pack({{pos.x, pos.y+height, pos.z+1}, ytype::direction::forward, texture_pos}),
+		chunk_vertex::pack({{pos.x+width, pos.y+height, pos.z+1}, ytype::direction::forward, texture_pos})});
+}
+
+void chunk_mesher::a_back_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept
+{
+	vertices.insert(vertices.end(), {chunk_vertex::pack({{pos.x, pos.y, pos.z}, ytype::direction::back, texture_pos}),
+		chunk_vertex::pack({{pos.x+width, pos.y, pos.z}, ytype::direction::back, texture_pos}),
+		chunk_vertex::pack({{pos.x, pos.y+height, pos.z}, ytype::direction::back, texture_pos}),
+		chunk_vertex::pack({{pos.x+width, pos.y+height, pos.z}, ytype::direction::back, texture_pos})});
+}
+
+void chunk_mesher::a_left_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept
+{
+	vertices.insert(vertices.end(), {chunk_vertex::pack({{pos.x, pos.y, pos.z}, ytype::direction::left, texture_pos}),
+		chunk_vertex::pack({{pos.x, pos.y, pos.z+width}, ytype::direction::left, texture_pos}),
+		chunk_vertex::pack({{pos.x, pos.y+height, pos.z}, ytype::direction::left, texture_pos}),
+		chunk_vertex::pack({{pos.x, pos.y+height, pos.z+width}, ytype::direction::left, texture_pos})});
+}
+
+void chunk_mesher::a_right_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept
+{
+	vertices.insert(vertices.end(), {chunk_vertex::pack({{pos.x+1, pos.y, pos.z}, ytype::direction::right, texture_pos}),
+		chunk_vertex::pack({{pos.x+1, pos.y, pos.z+width}, ytype::direction::right, texture_pos}),
+		chunk_vertex::pack({{pos.x+1, pos.y+height, pos.z}, ytype::direction::right, texture_pos}),
+		chunk_vertex::pack({{pos.x+1, pos.y+height, pos.z+width}, ytype::direction::right, texture_pos})});
+}
+
+void chunk_mesher::a_up_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept
+{
+	vertices.insert(vertices.end(), {chunk_vertex::pack({{pos.x, pos.y+1, pos.z}, ytype::direction::up, texture_pos}),
+		chunk_vertex::pack({{pos.x+width, pos.y+1, pos.z}, ytype::direction::up, texture_pos}),
+		chunk_vertex::pack({{pos.x, pos.y+1, pos.z+height}, ytype::direction::up, texture_pos}),
+		chunk_vertex::pack({{pos.x+width, pos.y+1, pos.z+height}, ytype::direction::up, texture_pos})});
+}
+
+void chunk_mesher::a_down_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept
+{
+	vertices.insert(vertices.end(), {chunk_vertex::pack({{pos.x, pos.y, pos.z}, ytype::direction::down, texture_pos}),
+		chunk_vertex::pack({{pos.x+width, pos.y, pos.z}, ytype::direction::down, texture_pos}),
+		chunk_vertex::pack({{pos.x, pos.y, pos.z+height}, ytype::direction::down, texture_pos}),
+		chunk_vertex::pack({{pos.x+width, pos.y, pos.z+height}, ytype::direction::down, texture_pos})});
+}
@@ -0,0 +1,216 @@
+#ifndef Y_CMESHER_H
+#define Y_CMESHER_H
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <cstdint>
+
+#include "chunk.h"
+#include "cvertex.h"
+
+//packed chunk_vertex vertices of a chunk, doesnt touch any gl state so it can be built on any thread
+struct chunk_mesh
+{
+	//opaque faces are split by their side (direction-1), so the ones facing away from the camera can be skipped
+	std::array<std::vector<std::uint32_t>, 6> opaque;
+	std::vector<std::uint32_t> transparent;
+
+	//where the vertices of each slab (the slices of one layer of bricks) start, by side and slab along the sides axis
+	//the last offset is the end of the side, edits only rebuild the slabs of the bricks they touched
+	typedef std::array<std::array<std::uint32_t, world_chunk::bricks_side+1>, 6> slab_offsets;
+	slab_offsets opaque_slabs{};
+	slab_offsets transparent_slabs{};
+
+	int scale = 1;
+
+	//neighbours that werent loaded while meshing, the mesh has to be rebuilt once they are
+	world_types::wall_states missing;
+};
+
+//everything the mesh of a chunk made of a single block depends on
+//those are the chunks that repeat (all stone, all air, buried), so only they get keys
+struct mesh_key
+{
+	struct hasher
+	{
+		size_t operator()(const mesh_key& key) const noexcept;
+	};
+
+	world_block block;
+	int scale;
+
+	std::array<bool, 6> loaded;
+	//borders made of a single block only store that block
+	std::array<std::vector<world_block>, 6> borders;
+
+	bool operator==(const mesh_key&) const = default;
+};
+
+//copy of a chunk padded with the one block thick layers of its neighbours touching it
+//thats the whole 34^3 neighbourhood the faces depend on, edges and corners of it never touch a face so they arent stored
+//lods merge scale^3 blocks into cells, positions are in cells and the padding is one cell thick
+class padded_chunk
+{
+public:
+	padded_chunk(const world_chunk& chunk, const int scale = 1);
+
+	//neighbours that are never set count as opaque
+	//neighbour cells are taken at the neighbours own lod, finer ones show their most visible block
+	//so faces between chunks with different lods never leave holes
+	void set_neighbour(const ytype::direction side, const world_chunk& neighbour, const int neighbour_scale = 1) noexcept;
+
+	//builds the cells of a lod, done separately since its too slow for the main thread
+	void downsample() noexcept;
+
+	//positions can be up to one cell outside of the chunk
+	world_block block(const vec3d<int> pos) const noexcept;
+
+	//one bit per cell along the y axis
+	std::uint32_t solid_column(const int x, const int z) const noexcept;
+	std::uint32_t transparent_column(const int x, const int z) const noexcept;
+
+	const world_chunk& chunk() const noexcept;
+	world_types::wall_states missing() const noexcept;
+
+	//empty if the chunk has more than one block, the chunks position isnt part of it
+	std::optional<mesh_key> cache_key() const;
+
+	int scale() const noexcept;
+	//cells along each side
+	int size() const noexcept;
+
+private:
+	typedef std::array<world_block, world_types::chunk_size*world_types::chunk_size> border;
+
+	static vec3d<int> border_position(const ytype::direction side, const int a, const int b) noexcept;
+
+	static world_block scaled_block(const world_chunk& chunk, const vec3d<int> pos, const int scale) noexcept;
+	static int visibility(const world_block block) noexcept;
+
+	int index_cell(const vec3d<int> pos) const noexcept;
+
+	world_chunk _chunk;
+
+	//only used by lods
+	std::vector<world_block> _cells;
+	std::vector<std::uint32_t> _solid_columns;
+	std::vector<std::uint32_t> _transparent_columns;
+
+	std::array<border, 6> _borders;
+	std::array<bool, 6> _loaded{};
+
+	int _scale = 1;
+	int _size = world_types::chunk_size;
+};
+
+//finished meshes by the key of the padded chunk they were built from
+//chunks with the same blocks and borders share one immutable mesh, keys are compared in full so hash collisions cant mix meshes up
+//entries expire once no chunk model holds their mesh anymore, freed storage slots drop theirs
+class mesh_cache
+{
+public:
+	struct counters
+	{
+		size_t hits = 0;
+		size_t misses = 0;
+	};
+
+	mesh_cache();
+
+	//counts a hit or a miss
+	std::shared_ptr<const chunk_mesh> find(const mesh_key& key) noexcept;
+	void insert(const mesh_key& key, const std::shared_ptr<const chunk_mesh> mesh);
+
+	counters cache_counters() const noexcept;
+
+private:
+	void remove_unused() noexcept;
+
+	mutable std::mutex _mtx;
+	std::unordered_map<mesh_key, std::weak_ptr<const chunk_mesh>, mesh_key::hasher> _meshes;
+
+	//unused entries get removed once the cache grows past this
+	static constexpr size_t min_prune_size = 64;
+	size_t _prune_size = min_prune_size;
+
+	counters _counters;
+};
+
+//builds the mesh of a chunk into a chunk_mesh
+class chunk_mesher
+{
+public:
+	chunk_mesher(const padded_chunk& padded, chunk_mesh& mesh);
+
+	void build() noexcept;
+	//only meshes the slabs of the dirty bricks and copies the rest from a mesh of the same chunk before its edits
+	//builds everything if that mesh is at a different lod
+	void rebuild(const chunk_mesh& old_mesh, const std::uint64_t dirty_bricks) noexcept;
+
+#ifdef Y_GREEDY_MESH
+	static constexpr bool greedy_mesh = true;
+#else
+	static constexpr bool greedy_mesh = false;
+#endif
+
+private:
+	//visible faces of a chunk slice, one row per bit mask
+	//bits go along the faces texture u axis and rows along its v axis
+	typedef std::array<std::uint32_t, world_types::chunk_size> slice_faces;
+	typedef std::array<std::array<slice_faces, world_types::chunk_size>, 6> chunk_faces;
+
+	//opaque, non air transparent and air blocks of a column, one bit per y
+	struct column_masks
+	{
+		std::uint32_t opaque;
+		std::uint32_t transparent;
+		std::uint32_t air;
+	};
+
+	//bits of the slabs to mesh along the x, y and z axes, the other ones get copied from old_mesh
+	void build(const chunk_mesh* old_mesh, const std::array<std::uint32_t, 3> slabs) noexcept;
+	void add_slab(const ytype::direction side, const int slab, const chunk_faces& faces) noexcept;
+	void copy_slab(const ytype::direction side, const int slab, const chunk_mesh& old_mesh) noexcept;
+
+	static int side_axis(const ytype::direction side) noexcept;
+
+	column_masks column(const int x, const int z) const noexcept;
+	static column_masks block_masks(const world_block block, const int y) noexcept;
+
+	std::uint32_t visible_faces(const column_masks& c_column, const column_masks& check,
+		const vec3d<int> pos, const vec3d<int> offset) const noexcept;
+
+	void update_column_walls(const int x, const int z, chunk_faces& faces) const noexcept;
+
+	void add_slice(const ytype::direction side, const int slice, slice_faces faces) noexcept;
+	void add_face(const ytype::direction side, const vec3d<int> pos,
+		const int width, const int height, const world_block block) noexcept;
+
+	//width and height are in blocks along the faces texture u and v axes
+	static void a_forward_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept;
+	static void a_back_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept;
+	static void a_left_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept;
+	static void a_right_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept;
+	static void a_up_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept;
+	static void a_down_face(std::vector<std::uint32_t>& vertices, const vec3d<int> pos, const int width, const int height, const world_types::tex_pos texture_pos) noexcept;
+
+	static int side_index(const ytype::direction side) noexcept;
+	static vec3d<int> slice_position(const ytype::direction side, const int slice, const int row, const int bit) noexcept;
+	static bool merge_faces(const world_block block, const world_block check, const ytype::direction side) noexcept;
+
+	static bool draw_side(const world_block& block, const world_block& check) noexcept;
+	
+	const padded_chunk& _padded;
+	const world_chunk& _chunk;
+	chunk_mesh& _mesh;
+
+	//cells along each side and blocks per cell
+	const int _size;
+	const int _scale;
+};
+
+#endif
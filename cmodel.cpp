@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "cmodel.h"
 
 using namespace yangl;
@@ -9,16 +11,14 @@ model_holder::model_holder()
 
 model_holder::model_holder(const camera* cam, const generic_shader* shader, const texture_atlas& atlas)
 : _model(),
-_draw_object(cam, shader, &_model, atlas.texture),
-_distance_x(atlas.tex_offset_x), _distance_y(atlas.tex_offset_y)
+_draw_object(cam, shader, &_model, atlas.texture)
 {
 }
 
 model_holder::model_holder(const model_holder& other)
 : _model(other._model),
 _draw_object(other._draw_object),
-_index(other._index),
-_distance_x(other._distance_x), _distance_y(other._distance_y)
+_vertices(other._vertices)
 {
 	_draw_object.set_model(&_model);
 }
@@ -26,8 +26,10 @@ _distance_x(other._distance_x), _distance_y(other._distance_y)
 model_holder::model_holder(model_holder&& other) noexcept
 : _model(std::move(other._model)),
 _draw_object(std::move(other._draw_object)),
-_index(other._index),
-_distance_x(other._distance_x), _distance_y(other._distance_y)
+_vertices(std::move(other._vertices)),
+_dirty(other._dirty),
+_uploaded(other._uploaded),
+_uploaded_quads(other._uploaded_quads)
 {
 	_draw_object.set_model(&_model);
 }
@@ -40,10 +42,11 @@ model_holder& model_holder::operator=(const model_holder& other)
 		_draw_object = other._draw_object;
 		_draw_object.set_model(&_model);
 
-		_index = other._index;
+		_vertices = other._vertices;
 
-		_distance_x = other._distance_x;
-		_distance_y = other._distance_y;
+		//copies get their own buffers
+		_dirty = true;
+		_uploaded = false;
 	}
 	return *this;
 }
@@ -56,10 +59,11 @@ model_holder& model_holder::operator=(model_holder&& other) noexcept
 		_draw_object = std::move(other._draw_object);
 		_draw_object.set_model(&_model);
 
-		_index = other._index;
+		_vertices = std::move(other._vertices);
 
-		_distance_x = other._distance_x;
-		_distance_y = other._distance_y;
+		_dirty = other._dirty;
+		_uploaded = other._uploaded;
+		_uploaded_quads = other._uploaded_quads;
 	}
 	return *this;
 }
@@ -76,378 +80,269 @@ void model_holder::set_scale(const float scale) noexcept
 
 void model_holder::draw() noexcept
 {
-	_model.generate_buffers();
+	if(!_uploaded || _uploaded_quads==0)
+		return;
+
 	_draw_object.draw();
 }
 
 void model_holder::clear() noexcept
 {
-	_model.clear();
-	_index = 0;
+	_vertices = nullptr;
+	_dirty = true;
+
+	//the old buffers shouldnt be drawn anymore
+	_uploaded = false;
 }
 
-void model_holder::a_forward_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept
+void model_holder::set_vertices(const std::shared_ptr<const std::vector<std::uint32_t>> vertices) noexcept
 {
-	//i cant write any better code for these, it literally HAS to be hardcoded :/
-	_model.vertices_insert({pos_f.x, pos_f.y, pos_f.z+block_size, _distance_x*texture_pos.x, _distance_y*texture_pos.y,
-		pos_f.x+block_size, pos_f.y, pos_f.z+block_size, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y,
-		pos_f.x, pos_f.y+block_size, pos_f.z+block_size, _distance_x*texture_pos.x, _distance_y*texture_pos.y+_distance_y,
-		pos_f.x+block_size, pos_f.y+block_size, pos_f.z+block_size, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y+_distance_y});
-
-	_model.indices_insert({_index, _index+1, _index+2, _index+1, _index+3, _index+2});
-
-	_index += 4;
+	_vertices = vertices;
+	_dirty = true;
 }
 
-void model_holder::a_back_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept
+bool model_holder::dirty() const noexcept
 {
-	_model.vertices_insert({pos_f.x, pos_f.y, pos_f.z, _distance_x*texture_pos.x, _distance_y*texture_pos.y,
-		pos_f.x+block_size, pos_f.y, pos_f.z, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y,
-		pos_f.x, pos_f.y+block_size, pos_f.z, _distance_x*texture_pos.x, _distance_y*texture_pos.y+_distance_y,
-		pos_f.x+block_size, pos_f.y+block_size, pos_f.z, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y+_distance_y});
-
-	_model.indices_insert({_index, _index+2, _index+1, _index+1, _index+2, _index+3});
-
-	_index += 4;
+	return _dirty;
 }
 
-void model_holder::a_left_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept
+size_t model_holder::upload_size() const noexcept
 {
-	_model.vertices_insert({pos_f.x, pos_f.y, pos_f.z, _distance_x*texture_pos.x, _distance_y*texture_pos.y,
-		pos_f.x, pos_f.y, pos_f.z+block_size, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y,
-		pos_f.x, pos_f.y+block_size, pos_f.z, _distance_x*texture_pos.x, _distance_y*texture_pos.y+_distance_y,
-		pos_f.x, pos_f.y+block_size, pos_f.z+block_size, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y+_distance_y});
-
-	_model.indices_insert({_index, _index+1, _index+2, _index+1, _index+3, _index+2});
-
-	_index += 4;
+	return quads()*4*5*sizeof(float) + quads()*6*sizeof(int);
 }
 
-void model_holder::a_right_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept
+size_t model_holder::quads() const noexcept
 {
-	_model.vertices_insert({pos_f.x+block_size, pos_f.y, pos_f.z, _distance_x*texture_pos.x, _distance_y*texture_pos.y,
-		pos_f.x+block_size, pos_f.y, pos_f.z+block_size, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y,
-		pos_f.x+block_size, pos_f.y+block_size, pos_f.z, _distance_x*texture_pos.x, _distance_y*texture_pos.y+_distance_y,
-		pos_f.x+block_size, pos_f.y+block_size, pos_f.z+block_size, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y+_distance_y});
-
-	_model.indices_insert({_index, _index+2, _index+1, _index+1, _index+2, _index+3});
+	if(!_vertices)
+		return _uploaded ? _uploaded_quads : 0;
 
-	_index += 4;
+	return _vertices->size()/4;
 }
 
-void model_holder::a_up_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept
+void model_holder::upload() noexcept
 {
-	_model.vertices_insert({pos_f.x, pos_f.y+block_size, pos_f.z, _distance_x*texture_pos.x, _distance_y*texture_pos.y,
-		pos_f.x+block_size, pos_f.y+block_size, pos_f.z, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y,
-		pos_f.x, pos_f.y+block_size, pos_f.z+block_size, _distance_x*texture_pos.x, _distance_y*texture_pos.y+_distance_y,
-		pos_f.x+block_size, pos_f.y+block_size, pos_f.z+block_size, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y+_distance_y});
+	_model.clear();
 
-	_model.indices_insert({_index, _index+2, _index+1, _index+1, _index+2, _index+3});
+	//the model only takes float vertices
+	if(_vertices)
+	{
+		for(const auto& packed : *_vertices)
+		{
+			const std::array<float, 5> c_vertex = chunk_vertex::model_vertex(chunk_vertex::unpack(packed));
 
-	_index += 4;
-}
+			_model.vertices_insert({c_vertex[0], c_vertex[1], c_vertex[2], c_vertex[3], c_vertex[4]});
+		}
+	}
 
-void model_holder::a_down_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept
-{
-	_model.vertices_insert({pos_f.x, pos_f.y, pos_f.z, _distance_x*texture_pos.x, _distance_y*texture_pos.y,
-		pos_f.x+block_size, pos_f.y, pos_f.z, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y,
-		pos_f.x, pos_f.y, pos_f.z+block_size, _distance_x*texture_pos.x, _distance_y*texture_pos.y+_distance_y,
-		pos_f.x+block_size, pos_f.y, pos_f.z+block_size, _distance_x*texture_pos.x+_distance_x, _distance_y*texture_pos.y+_distance_y});
+	if(_vertices)
+	{
+		for(int index = 0; index < static_cast<int>(_vertices->size()); index += 4)
+		{
+			//these sides are mirrored, so their triangles wind the other way around
+			switch(chunk_vertex::unpack((*_vertices)[index]).side)
+			{
+				case ytype::direction::back:
+				case ytype::direction::right:
+				case ytype::direction::up:
+					_model.indices_insert({index, index+2, index+1, index+1, index+2, index+3});
+					break;
+
+				default:
+					_model.indices_insert({index, index+1, index+2, index+1, index+3, index+2});
+					break;
+			}
+		}
+	}
+
+	_model.generate_buffers();
 
-	_model.indices_insert({_index, _index+1, _index+2, _index+1, _index+3, _index+2});
+	_dirty = false;
+	_uploaded = true;
+	_uploaded_quads = quads();
 
-	_index += 4;
+	//yangl models only take float vertices so they keep their own copy, no need for the packed one too
+	_vertices = nullptr;
 }
 
-
-model_chunk::model_chunk()
+upload_queue::upload_queue()
 {
 }
 
-model_chunk::model_chunk(const world_chunk* owner,
-	const graphics_state& graphics)
-: _own_chunk(owner),
-_opaque_model(graphics.camera, graphics.shader, graphics.opaque_atlas),
-_transparent_model(graphics.camera, graphics.shader, graphics.transparent_atlas)
+upload_queue::upload_queue(const size_t frame_budget)
+: _frame_budget(frame_budget)
 {
-	const vec3d<float> chunk_pos{owner->position().cast<float>()*chunk_size};
-
-	_opaque_model.set_position(chunk_pos);
-	_transparent_model.set_position(chunk_pos);
+}
 
-	_opaque_model.set_scale(chunk_size);
-	_transparent_model.set_scale(chunk_size);
+void upload_queue::push(model_holder& model, const float distance)
+{
+	_queue.emplace_back(distance, &model);
 }
 
-void model_chunk::update_mesh() noexcept
+void upload_queue::upload() noexcept
 {
-	_opaque_model.clear();
-	_transparent_model.clear();
+	std::sort(_queue.begin(), _queue.end(), [](const auto& lhs, const auto& rhs){return lhs.first<rhs.first;});
 
-	_walls_empty = wall_states{};
-	_walls_full = false;
+	_counters.uploads = 0;
+	_counters.bytes = 0;
+	_counters.waiting = 0;
 
-	assert(_own_chunk!=nullptr);
-	if(_own_chunk->empty())
-		return;
-		
-	int block_index = 0;
-	for(int x = 0; x < chunk_size; ++x)
+	for(const auto& [distance, model] : _queue)
 	{
-		for(int y = 0; y < chunk_size; ++y)
+		const size_t c_size = model->upload_size();
+
+		//the nearest mesh always goes through so a huge one cant stall the queue
+		if(_counters.uploads!=0 && _counters.bytes+c_size>_frame_budget)
 		{
-			for(int z = 0; z < chunk_size; ++z, ++block_index)
-			{	
-				if(_own_chunk->blocks[block_index].block_type!=block::air)
-					update_block_walls({x, y, z}, block_index);
-			}
+			++_counters.waiting;
+			continue;
 		}
-	}
-}
 
-void model_chunk::update_wall(const world_chunk& check_chunk, const ytype::direction wall) noexcept
-{
-	assert(_own_chunk!=nullptr);
-	if(_own_chunk->empty())
-		return;
-		
+		model->upload();
 
-	switch(wall)
-	{
-		default:
-		case ytype::direction::right:
-			if(_walls_empty.right)
-				update_wall_x<true>(check_chunk);
-			break;
-		
-		case ytype::direction::left:
-			if(_walls_empty.left)
-				update_wall_x<false>(check_chunk);
-			break;
-		
-		case ytype::direction::up:
-			if(_walls_empty.up)
-				update_wall_y<true>(check_chunk);
-			break;
-		
-		case ytype::direction::down:
-			if(_walls_empty.down)
-				update_wall_y<false>(check_chunk);
-			break;
-		
-		case ytype::direction::forward:
-			if(_walls_empty.forward)
-				update_wall_z<true>(check_chunk);
-			break;
-		
-		case ytype::direction::back:
-			if(_walls_empty.back)
-				update_wall_z<false>(check_chunk);
-			break;
+		++_counters.uploads;
+		_counters.bytes += c_size;
 	}
-	
-	_walls_full = !_walls_empty.walls_or();
-}
 
-void model_chunk::draw_opaque() noexcept
-{
-	_opaque_model.draw();
-}
+	_counters.total_uploads += _counters.uploads;
 
-void model_chunk::draw_transparent() noexcept
-{
-	_transparent_model.draw();
+	_queue.clear();
 }
 
-wall_states model_chunk::walls() const noexcept
+const upload_queue::counters& upload_queue::frame_counters() const noexcept
 {
-	return _walls_empty;
+	return _counters;
 }
 
-bool model_chunk::walls_full() const noexcept
+
+model_chunk::model_chunk()
 {
-	return _walls_full;
 }
 
-void model_chunk::set_owner(const world_chunk* owner) noexcept
+model_chunk::model_chunk(const vec3d<int> position,
+	const graphics_state& graphics)
+: _transparent_model(graphics.camera, graphics.shader, graphics.transparent_atlas)
 {
-	_own_chunk = owner;
+	_opaque_models.fill(model_holder(graphics.camera, graphics.shader, graphics.opaque_atlas));
+
+	for(auto& model : _opaque_models)
+		model.set_scale(chunk_size);
+
+	_transparent_model.set_scale(chunk_size);
+
+	set_position(position);
 }
 
-void model_chunk::update_block_walls(const vec3d<int> pos) noexcept
+void model_chunk::reset(const vec3d<int> position) noexcept
 {
-	update_block_walls(pos, pos.x*chunk_size*chunk_size+pos.y*chunk_size+pos.z);
+	set_position(position);
+	clear();
 }
 
-void model_chunk::update_block_walls(const vec3d<int> pos, const int index) noexcept
+void model_chunk::clear() noexcept
 {
-	const world_chunk::chunk_blocks& blocks = _own_chunk->blocks;
-	
-	const world_block& c_block = blocks[index];
-	const texture_face& c_texture = c_block.texture();
+	for(auto& model : _opaque_models)
+		model.clear();
 
-	model_holder& c_model = c_block.transparent() ? _transparent_model : _opaque_model;
-	const vec3d<float> pos_f{pos.cast<float>()*c_model.block_size};
+	_transparent_model.clear();
 
-	if(pos.z!=(chunk_size-1) && draw_side(c_block, blocks[index+1]))
-		c_model.a_forward_face(pos_f, c_texture.forward);
-	
-	if(pos.z!=0 && draw_side(c_block, blocks[index-1]))
-		c_model.a_back_face(pos_f, c_texture.back);
+	_mesh = nullptr;
 
-	if(pos.y!=(chunk_size-1) && draw_side(c_block, blocks[index+chunk_size]))
-		c_model.a_up_face(pos_f, c_texture.up);
+	_missing_neighbours = wall_states{};
+}
 
-	if(pos.y!=0 && draw_side(c_block, blocks[index-chunk_size]))
-		c_model.a_down_face(pos_f, c_texture.down);
+void model_chunk::set_mesh(const std::shared_ptr<const chunk_mesh> mesh) noexcept
+{
+	//the model vertices keep the whole mesh alive
+	for(int i = 0; i < 6; ++i)
+		_opaque_models[i].set_vertices(std::shared_ptr<const std::vector<std::uint32_t>>(mesh, &mesh->opaque[i]));
 
-	if(pos.x!=(chunk_size-1) && draw_side(c_block, blocks[index+chunk_size*chunk_size]))
-		c_model.a_right_face(pos_f, c_texture.right);
+	_transparent_model.set_vertices(std::shared_ptr<const std::vector<std::uint32_t>>(mesh, &mesh->transparent));
 
-	if(pos.x!=0 && draw_side(c_block, blocks[index-chunk_size*chunk_size]))
-		c_model.a_left_face(pos_f, c_texture.left);
+	_missing_neighbours = mesh->missing;
+
+	_mesh = mesh->scale==1 ? mesh : nullptr;
 }
 
-template<bool right_wall>
-void model_chunk::update_wall_x(const world_chunk& check_chunk) noexcept
+std::shared_ptr<const chunk_mesh> model_chunk::mesh() const noexcept
 {
-	const world_chunk::chunk_blocks& blocks = _own_chunk->blocks;
-	const world_chunk::chunk_blocks& check_blocks = check_chunk.blocks;
+	return _mesh;
+}
 
-	const int starting_index = (chunk_size-1)*chunk_size*chunk_size;
-	int block_index = starting_index;
-	
-	for(int y = 0; y < chunk_size; ++y)
+void model_chunk::queue_uploads(upload_queue& queue, const float distance) noexcept
+{
+	for(auto& model : _opaque_models)
 	{
-		for(int z = 0; z < chunk_size; ++z, ++block_index)
-		{
-			const world_block c_block = right_wall?
-				blocks[block_index]
-				: blocks[block_index-starting_index];
-
-			if(c_block.block_type!=block::air)
-			{
-				if(!check_chunk.empty())
-				{
-					const world_block check_block = right_wall?
-						check_blocks[block_index-starting_index]
-						: check_blocks[block_index];
-
-					if(!draw_side(c_block, check_block))
-						continue;
-				}
-
-				model_holder& c_model = c_block.transparent() ? _transparent_model : _opaque_model;
-
-				if(right_wall)
-					c_model.a_right_face(
-						vec3d<int>{chunk_size-1, y, z}.cast<float>()*c_model.block_size,
-						c_block.texture().right);
-				else
-					c_model.a_left_face(
-						vec3d<int>{0, y, z}.cast<float>()*c_model.block_size,
-						c_block.texture().left);
-			}
-		}
+		if(model.dirty())
+			queue.push(model, distance);
 	}
-	
-	if(right_wall)
-		_walls_empty.right = false;
-	else
-		_walls_empty.left = false;
+
+	if(_transparent_model.dirty())
+		queue.push(_transparent_model, distance);
 }
 
-template<bool up_wall>
-void model_chunk::update_wall_y(const world_chunk& check_chunk) noexcept
+void model_chunk::draw_opaque(const vec3d<float> camera_pos) noexcept
 {
-	for(int x = 0; x < chunk_size; ++x)
+	for(const auto side : {ytype::direction::left, ytype::direction::right, ytype::direction::forward,
+		ytype::direction::back, ytype::direction::down, ytype::direction::up})
 	{
-		for(int z = 0; z < chunk_size; ++z)
-		{
-			const world_block c_block = up_wall?
-				_own_chunk->block({x, chunk_size-1, z})
-				: _own_chunk->block({x, 0, z});
-					
-			if(c_block.block_type!=block::air)
-			{
-				const world_block check_block = up_wall?
-					check_chunk.block({x, 0, z})
-					: check_chunk.block({x, chunk_size-1, z});
-
-				if(check_chunk.empty() || draw_side(c_block, check_block))
-				{
-					model_holder& c_model = c_block.transparent() ? _transparent_model : _opaque_model;
-
-					if(up_wall)
-						c_model.a_up_face(
-							vec3d<int>{x, chunk_size-1, z}.cast<float>()*c_model.block_size,
-							c_block.texture().up);
-					else
-						c_model.a_down_face(
-							vec3d<int>{x, 0, z}.cast<float>()*c_model.block_size,
-							c_block.texture().down);
-				}
-			}
-		}
+		if(side_visible(side, _position, camera_pos))
+			_opaque_models[static_cast<int>(side)-1].draw();
 	}
+}
 
-	if(up_wall)
-		_walls_empty.up = false;
-	else
-		_walls_empty.down = false;
+void model_chunk::draw_transparent() noexcept
+{
+	_transparent_model.draw();
 }
 
-template<bool forward_wall>
-void model_chunk::update_wall_z(const world_chunk& check_chunk) noexcept
+size_t model_chunk::quads() const noexcept
 {
-	const world_chunk::chunk_blocks& blocks = _own_chunk->blocks;
-	const world_chunk::chunk_blocks& check_blocks = check_chunk.blocks;
+	size_t quads = _transparent_model.quads();
 
-	int block_index = 0;
+	for(const auto& model : _opaque_models)
+		quads += model.quads();
 
-	for(int x = 0; x < chunk_size; ++x)
-	{
-		for(int y = 0; y < chunk_size; ++y, block_index+=chunk_size)
-		{
-			const world_block c_block = forward_wall?
-			blocks[block_index+chunk_size-1]
-			: blocks[block_index];
+	return quads;
+}
 
-			if(c_block.block_type!=block::air)
-			{
-				if(!check_chunk.empty())
-				{
-					const world_block check_block = forward_wall?
-					check_blocks[block_index]
-					: check_blocks[block_index+chunk_size-1];
-
-					if(!draw_side(c_block, check_block))
-						continue;
-				}
-
-				model_holder& c_model = c_block.transparent() ? _transparent_model : _opaque_model;
-
-				if(forward_wall)
-					c_model.a_forward_face(
-						vec3d<int>{x, y, chunk_size-1}.cast<float>()*c_model.block_size,
-						c_block.texture().forward);
-				else
-					c_model.a_back_face(
-						vec3d<int>{x, y, 0}.cast<float>()*c_model.block_size,
-						c_block.texture().back);
-			}
-		}
+wall_states model_chunk::missing_neighbours() const noexcept
+{
+	return _missing_neighbours;
+}
+
+bool model_chunk::side_visible(const ytype::direction side, const vec3d<int> position, const vec3d<float> camera_pos) noexcept
+{
+	const vec3d<float> chunk_start = position.cast<float>()*chunk_size;
+	const vec3d<float> chunk_end = chunk_start+vec3d<float>{chunk_size, chunk_size, chunk_size};
+
+	switch(side)
+	{
+		default:
+		case ytype::direction::right:
+			return camera_pos.x>chunk_start.x;
+		case ytype::direction::left:
+			return camera_pos.x<chunk_end.x;
+		case ytype::direction::up:
+			return camera_pos.y>chunk_start.y;
+		case ytype::direction::down:
+			return camera_pos.y<chunk_end.y;
+		case ytype::direction::forward:
+			return camera_pos.z>chunk_start.z;
+		case ytype::direction::back:
+			return camera_pos.z<chunk_end.z;
 	}
-	
-	if(forward_wall)
-		_walls_empty.forward = false;
-	else
-		_walls_empty.back = false;
 }
 
-bool model_chunk::draw_side(const world_block& block, const world_block& check) noexcept
+void model_chunk::set_position(const vec3d<int> position) noexcept
 {
-	return check.transparent() && (block.block_type != check.block_type);
+	_position = position;
+
+	const vec3d<float> chunk_pos{position.cast<float>()*chunk_size};
+
+	for(auto& model : _opaque_models)
+		model.set_position(chunk_pos);
+
+	_transparent_model.set_position(chunk_pos);
 }
 
 full_chunk::full_chunk()
@@ -456,21 +351,18 @@ full_chunk::full_chunk()
 
 full_chunk::full_chunk(const world_chunk chunk,
 	const graphics_state& graphics)
-: chunk(chunk), model(&this->chunk, graphics)
+: chunk(chunk), model(chunk.position(), graphics)
 {
-	model.update_mesh();
 }
 
 full_chunk::full_chunk(const full_chunk& other)
 : chunk(other.chunk), model(other.model)
 {
-	model.set_owner(&chunk);
 }
 
 full_chunk::full_chunk(full_chunk&& other) noexcept
 : chunk(std::move(other.chunk)), model(std::move(other.model))
 {
-	model.set_owner(&chunk);
 }
 
 full_chunk& full_chunk::operator=(const full_chunk& other)
@@ -479,7 +371,6 @@ full_chunk& full_chunk::operator=(const full_chunk& other)
 	{
 		chunk = other.chunk;
 		model = other.model;
-		model.set_owner(&chunk);
 	}
 	return *this;
 }
@@ -490,7 +381,6 @@ full_chunk& full_chunk::operator=(full_chunk&& other) noexcept
 	{
 		chunk = std::move(other.chunk);
 		model = std::move(other.model);
-		model.set_owner(&chunk);
 	}
 	return *this;
 }
\ No newline at end of file
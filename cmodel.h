@@ -5,12 +5,12 @@
 
 #include "textures.h"
 #include "chunk.h"
+#include "cmesher.h"
 
+//unpacks mesh vertices into the five float vertices yangl models take, the only part of chunk meshing that needs gl
 class model_holder
 {
 public:
-	static constexpr float block_size = 1.0f/static_cast<float>(world_types::chunk_size);
-
 	model_holder();
 	model_holder(const yangl::camera* cam, const yangl::generic_shader* shader, const texture_atlas& atlas);
 
@@ -26,62 +26,107 @@ public:
 
 	void clear() noexcept;
 
-	void a_forward_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept;
-	void a_back_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept;
-	void a_left_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept;
-	void a_right_face( const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept;
-	void a_up_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept;
-	void a_down_face(const vec3d<float> pos_f, const world_types::tex_pos texture_pos) noexcept;
+	//mesh changed since the last upload
+	bool dirty() const noexcept;
+	size_t upload_size() const noexcept;
+
+	size_t quads() const noexcept;
+
+	void upload() noexcept;
+
+	//vertices can be shared with other models, theyre never changed
+	//the model lets go of them once theyre uploaded
+	void set_vertices(const std::shared_ptr<const std::vector<std::uint32_t>> vertices) noexcept;
 
 private:
 	yangl::core::model_manual _model;
 	yangl::generic_object _draw_object;
 
-	int _index;
+	//packed chunk_vertex vertices of the mesh waiting for an upload, _model keeps the float copy after that
+	std::shared_ptr<const std::vector<std::uint32_t>> _vertices;
+
+	bool _dirty = true;
+	bool _uploaded = false;
+
+	//empty buffers arent drawn at all
+	size_t _uploaded_quads = 0;
+};
+
+//dirty meshes of a frame, uploaded nearest first until the frame budget (in bytes) runs out
+//meshes over the budget keep drawing their old buffers and get queued again next frame
+class upload_queue
+{
+public:
+	struct counters
+	{
+		int uploads = 0;
+		size_t bytes = 0;
+		int waiting = 0;
+
+		size_t total_uploads = 0;
+	};
+
+	upload_queue();
+	upload_queue(const size_t frame_budget);
+
+	void push(model_holder& model, const float distance);
 
-	float _distance_x;
-	float _distance_y;
+	void upload() noexcept;
+
+	const counters& frame_counters() const noexcept;
+
+private:
+	std::vector<std::pair<float, model_holder*>> _queue;
+
+	size_t _frame_budget = 0;
+
+	counters _counters;
 };
 
 class model_chunk
 {
 public:
 	model_chunk();
-	model_chunk(const world_chunk* owner,
+	model_chunk(const vec3d<int> position,
 		const graphics_state& graphics);
 
-	void update_mesh() noexcept;
-	
-	void update_wall(const world_chunk& check_chunk, const ytype::direction wall) noexcept;
+	//drops the mesh and moves the model to another chunk, keeps the buffers around
+	void reset(const vec3d<int> position) noexcept;
+	//drops the mesh so the mesh cache can let go of it
+	void clear() noexcept;
 
-	void draw_opaque() noexcept;
+	//finished meshes can be shared between chunks with the same contents
+	void set_mesh(const std::shared_ptr<const chunk_mesh> mesh) noexcept;
+	//the last full resolution mesh set, edits get meshed on top of it
+	//lod meshes arent kept around once uploaded, their edits mesh the whole chunk
+	std::shared_ptr<const chunk_mesh> mesh() const noexcept;
+
+	void queue_uploads(upload_queue& queue, const float distance) noexcept;
+
+	//skips the sides that face away from the camera
+	void draw_opaque(const vec3d<float> camera_pos) noexcept;
 	void draw_transparent() noexcept;
+
+	size_t quads() const noexcept;
 	
-	world_types::wall_states walls() const noexcept;
-	bool walls_full() const noexcept;
+	//neighbours that werent loaded when the current mesh was built
+	world_types::wall_states missing_neighbours() const noexcept;
 
-	void set_owner(const world_chunk* owner) noexcept;
+	//a side can only be seen from the front of its faces, so only if the camera is past the nearest plane they can be on
+	static bool side_visible(const ytype::direction side, const vec3d<int> position, const vec3d<float> camera_pos) noexcept;
 
 private:
-	void update_block_walls(const vec3d<int> pos) noexcept;
-	void update_block_walls(const vec3d<int> pos, const int index) noexcept;
+	void set_position(const vec3d<int> position) noexcept;
 
-	template<bool right_wall>
-	void update_wall_x(const world_chunk& check_chunk) noexcept;
-	template<bool up_wall>
-	void update_wall_y(const world_chunk& check_chunk) noexcept;
-	template<bool forward_wall>
-	void update_wall_z(const world_chunk& check_chunk) noexcept;
+	//one model per opaque side, indexed by direction-1
+	std::array<model_holder, 6> _opaque_models;
+	model_holder _transparent_model;
 
-	static bool draw_side(const world_block& block, const world_block& check) noexcept;
+	std::shared_ptr<const chunk_mesh> _mesh;
 	
-	const world_chunk* _own_chunk = nullptr;
+	vec3d<int> _position{0, 0, 0};
 
-	model_holder _opaque_model;
-	model_holder _transparent_model;
-	
-	world_types::wall_states _walls_empty;
-	bool _walls_full = false;
+	world_types::wall_states _missing_neighbours;
 };
 
 struct full_chunk
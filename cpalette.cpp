@@ -0,0 +1,250 @@
+#include <cassert>
+#include <algorithm>
+
+#include "cpalette.h"
+
+
+chunk_palette::chunk_palette(const int size, const world_block block)
+: _size(size)
+{
+	fill(block);
+}
+
+world_block chunk_palette::get(const int index) const noexcept
+{
+	return _entries[get_entry(index)];
+}
+
+world_block chunk_palette::set(const int index, const world_block block) noexcept
+{
+	const int old_entry = get_entry(index);
+	const world_block old_block = _entries[old_entry];
+
+	if(old_block==block)
+		return old_block;
+
+	int entry = find_entry(block);
+	if(entry==-1)
+	{
+		if(_counts[old_entry]==1)
+		{
+			//the old block was the only one of its kind, so it can be replaced in place
+			_entries[old_entry] = block;
+			return old_block;
+		}
+
+		entry = add_entry(block);
+	}
+
+	set_entry(index, entry);
+
+	if(_counts[entry]==0)
+		++_live_entries;
+
+	++_counts[entry];
+	--_counts[old_entry];
+
+	if(_counts[old_entry]==0)
+		remove_entry(old_entry);
+
+	return old_block;
+}
+
+void chunk_palette::fill(const world_block block) noexcept
+{
+	reset(block);
+
+	_data = std::vector<std::uint64_t>();
+}
+
+void chunk_palette::reset(const world_block block) noexcept
+{
+	_entries.assign(1, block);
+	_counts.assign(1, _size);
+
+	_data.clear();
+
+	_live_entries = 1;
+	_bits = 0;
+}
+
+bool chunk_palette::uniform() const noexcept
+{
+	return _bits==0;
+}
+
+int chunk_palette::bits() const noexcept
+{
+	return _bits;
+}
+
+int chunk_palette::entries_amount() const noexcept
+{
+	return _live_entries;
+}
+
+size_t chunk_palette::memory_usage() const noexcept
+{
+	return sizeof(*this)
+		+ _entries.capacity()*sizeof(world_block)
+		+ _counts.capacity()*sizeof(int)
+		+ _data.capacity()*sizeof(std::uint64_t);
+}
+
+int chunk_palette::get_entry(const int index) const noexcept
+{
+	assert(index>=0 && index<_size);
+
+	if(_bits==0)
+		return 0;
+
+	return packed_entry(_data, index, _bits);
+}
+
+void chunk_palette::set_entry(const int index, const int entry) noexcept
+{
+	assert(index>=0 && index<_size);
+	assert(entry < (1<<_bits));
+
+	if(_bits==0)
+		return;
+
+	set_packed_entry(_data, index, _bits, entry);
+}
+
+int chunk_palette::find_entry(const world_block block) const noexcept
+{
+	for(int i = 0; i < static_cast<int>(_entries.size()); ++i)
+	{
+		if(_counts[i]!=0 && _entries[i]==block)
+			return i;
+	}
+
+	return -1;
+}
+
+int chunk_palette::add_entry(const world_block block) noexcept
+{
+	for(int i = 0; i < static_cast<int>(_entries.size()); ++i)
+	{
+		if(_counts[i]==0)
+		{
+			_entries[i] = block;
+			return i;
+		}
+	}
+
+	//no free spots left, indices need more bits
+	if(_entries.size() >= (size_t(1)<<_bits))
+		repack(needed_bits(_entries.size()+1));
+
+	_entries.push_back(block);
+	_counts.push_back(0);
+
+	return _entries.size()-1;
+}
+
+void chunk_palette::remove_entry(const int entry) noexcept
+{
+	assert(_counts[entry]==0);
+
+	--_live_entries;
+
+	//shrinks to a width with room for twice the live entries, so edits going back and forth
+	//over a power of two dont repack the whole chunk every time
+	//a single block always shrinks to 0 bits, that repack doesnt touch the indices
+	const int new_bits = _live_entries==1 ? 0 : needed_bits(_live_entries*2);
+	if(new_bits < _bits)
+		repack(new_bits);
+}
+
+void chunk_palette::repack(const int bits) noexcept
+{
+	std::vector<int> remap(_entries.size(), 0);
+
+	//removed entries get dropped, the live ones keep their order
+	int live = 0;
+	for(size_t i = 0; i < _entries.size(); ++i)
+	{
+		if(_counts[i]!=0)
+		{
+			remap[i] = live;
+
+			_entries[live] = _entries[i];
+			_counts[live] = _counts[i];
+			++live;
+		}
+	}
+
+	_entries.resize(live);
+	_counts.resize(live);
+
+	const int old_bits = _bits;
+	const size_t words = (static_cast<size_t>(_size)*bits+63)/64;
+
+	//indices are rewritten in place so the data keeps its allocation
+	//growing goes backwards and shrinking forwards, that way no index gets overwritten before its read
+	if(bits>old_bits)
+		_data.resize(words, 0);
+
+	const auto move_index = [this, &remap, bits, old_bits](const int index)
+	{
+		set_packed_entry(_data, index, bits, remap[packed_entry(_data, index, old_bits)]);
+	};
+
+	//going from or to a single block all the indices are 0, so theres nothing to move
+	if(bits!=0 && old_bits!=0)
+	{
+		if(bits>old_bits)
+		{
+			for(int i = _size-1; i >= 0; --i)
+				move_index(i);
+		} else
+		{
+			for(int i = 0; i < _size; ++i)
+				move_index(i);
+		}
+	}
+
+	//a single block chunk needs no indices, dont keep the old ones allocated
+	if(bits==0)
+		std::vector<std::uint64_t>().swap(_data);
+	else if(bits<old_bits)
+		_data.resize(words);
+
+	_bits = bits;
+}
+
+int chunk_palette::packed_entry(const std::vector<std::uint64_t>& data, const int index, const int bits) noexcept
+{
+	const int bit = index*bits;
+	const std::uint64_t mask = (std::uint64_t(1)<<bits)-1;
+
+	return (data[bit>>6] >> (bit&63)) & mask;
+}
+
+void chunk_palette::set_packed_entry(std::vector<std::uint64_t>& data, const int index, const int bits, const int entry) noexcept
+{
+	const int bit = index*bits;
+	const std::uint64_t mask = (std::uint64_t(1)<<bits)-1;
+
+	std::uint64_t& word = data[bit>>6];
+	word = (word & ~(mask<<(bit&63))) | (static_cast<std::uint64_t>(entry)<<(bit&63));
+}
+
+int chunk_palette::needed_bits(const int entries) noexcept
+{
+	//only power of 2 widths so an index never crosses a word boundary
+	if(entries<=1)
+		return 0;
+	else if(entries<=2)
+		return 1;
+	else if(entries<=4)
+		return 2;
+	else if(entries<=16)
+		return 4;
+	else if(entries<=256)
+		return 8;
+	else
+		return 16;
+}
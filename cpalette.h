@@ -0,0 +1,65 @@
+#ifndef Y_CPALETTE_H
+#define Y_CPALETTE_H
+
+#include <vector>
+#include <cstdint>
+
+#include "wblock.h"
+
+//stores blocks as bit packed indices into a small list of unique blocks
+//a palette with a single block (0 bits) is uniform and doesnt store any indices
+class chunk_palette
+{
+public:
+	chunk_palette(const int size, const world_block block);
+
+	world_block get(const int index) const noexcept;
+	world_block set(const int index, const world_block block) noexcept;
+
+	void fill(const world_block block) noexcept;
+	//same as fill but keeps the allocations around for the next blocks
+	void reset(const world_block block) noexcept;
+
+	template<typename F>
+	void for_each_entry(F func) noexcept
+	{
+		for(size_t i = 0; i < _entries.size(); ++i)
+		{
+			if(_counts[i]!=0)
+				func(_entries[i]);
+		}
+	}
+
+	bool uniform() const noexcept;
+
+	int bits() const noexcept;
+	int entries_amount() const noexcept;
+
+	size_t memory_usage() const noexcept;
+
+private:
+	int get_entry(const int index) const noexcept;
+	void set_entry(const int index, const int entry) noexcept;
+
+	int find_entry(const world_block block) const noexcept;
+	int add_entry(const world_block block) noexcept;
+	void remove_entry(const int entry) noexcept;
+
+	void repack(const int bits) noexcept;
+
+	static int packed_entry(const std::vector<std::uint64_t>& data, const int index, const int bits) noexcept;
+	static void set_packed_entry(std::vector<std::uint64_t>& data, const int index, const int bits, const int entry) noexcept;
+
+	static int needed_bits(const int entries) noexcept;
+
+	std::vector<world_block> _entries;
+	std::vector<int> _counts;
+
+	std::vector<std::uint64_t> _data;
+
+	int _size = 0;
+	int _live_entries = 0;
+	int _bits = 0;
+};
+
+#endif
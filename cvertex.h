@@ -0,0 +1,123 @@
+#ifndef Y_CVERTEX_H
+#define Y_CVERTEX_H
+
+#include <array>
+#include <cstdint>
+
+#include "types.h"
+#include "worldtypes.h"
+#include "wregistry.h"
+
+
+//chunk mesh vertex packed into 32 bits
+//x, y and z take 6 bits each (0 to chunk_size inclusive), the face side 3 bits and the atlas tile 4 bits per axis
+//texture coordinates arent stored, they follow from the position along the faces u and v axes
+//only the meshes on the cpu side are packed, the gpu buffers still get model_vertex floats
+namespace chunk_vertex
+{
+	constexpr int position_bits = 6;
+	constexpr int side_bits = 3;
+	constexpr int tile_bits = 4;
+
+	constexpr int side_shift = position_bits*3;
+	constexpr int tile_shift = side_shift+side_bits;
+
+	constexpr int position_mask = (1<<position_bits)-1;
+	constexpr int side_mask = (1<<side_bits)-1;
+	constexpr int tile_mask = (1<<tile_bits)-1;
+
+	//texture coordinates store the atlas tile times the stride plus how many times the tile repeats
+	//the offset keeps interpolated coordinates away from the tile edge, the chunk shader unpacks both
+	constexpr float tile_stride = 64.0f;
+	constexpr float tile_offset = 8.0f;
+
+	struct vertex
+	{
+		vec3d<int> position;
+		ytype::direction side;
+		world_types::tex_pos tile;
+
+		bool operator==(const vertex&) const = default;
+	};
+
+	constexpr std::uint32_t pack(const vertex vert) noexcept
+	{
+		return static_cast<std::uint32_t>(vert.position.x)
+			| (static_cast<std::uint32_t>(vert.position.y)<<position_bits)
+			| (static_cast<std::uint32_t>(vert.position.z)<<(position_bits*2))
+			| (static_cast<std::uint32_t>(vert.side)<<side_shift)
+			| (static_cast<std::uint32_t>(vert.tile.x)<<tile_shift)
+			| (static_cast<std::uint32_t>(vert.tile.y)<<(tile_shift+tile_bits));
+	}
+
+	constexpr vertex unpack(const std::uint32_t packed) noexcept
+	{
+		return vertex{
+			vec3d<int>{static_cast<int>(packed & position_mask),
+				static_cast<int>((packed>>position_bits) & position_mask),
+				static_cast<int>((packed>>(position_bits*2)) & position_mask)},
+			static_cast<ytype::direction>((packed>>side_shift) & side_mask),
+			world_types::tex_pos{static_cast<int>((packed>>tile_shift) & tile_mask),
+				static_cast<int>((packed>>(tile_shift+tile_bits)) & tile_mask)}};
+	}
+
+	//position along the faces texture axes
+	constexpr int texture_u(const vertex vert) noexcept
+	{
+		switch(vert.side)
+		{
+			case ytype::direction::right:
+			case ytype::direction::left:
+				return vert.position.z;
+
+			default:
+				return vert.position.x;
+		}
+	}
+
+	constexpr int texture_v(const vertex vert) noexcept
+	{
+		switch(vert.side)
+		{
+			case ytype::direction::up:
+			case ytype::direction::down:
+				return vert.position.z;
+
+			default:
+				return vert.position.y;
+		}
+	}
+
+	//position in chunk units followed by the texture coordinates, what the chunk shader takes
+	constexpr std::array<float, 5> model_vertex(const vertex vert) noexcept
+	{
+		const float block_size = 1.0f/static_cast<float>(world_types::chunk_size);
+
+		return {vert.position.x*block_size, vert.position.y*block_size, vert.position.z*block_size,
+			tile_stride*vert.tile.x+tile_offset+texture_u(vert),
+			tile_stride*vert.tile.y+tile_offset+texture_v(vert)};
+	}
+
+	constexpr bool tiles_fit() noexcept
+	{
+		for(const auto& c_properties : block_registry::properties)
+		{
+			const world_types::texture_face& c_texture = c_properties.texture;
+
+			for(const auto& tile : {c_texture.forward, c_texture.back, c_texture.right,
+				c_texture.left, c_texture.up, c_texture.down})
+			{
+				if(tile.x<0 || tile.y<0 || tile.x>tile_mask || tile.y>tile_mask)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	static_assert(world_types::chunk_size <= position_mask, "chunk positions dont fit in a packed vertex");
+	static_assert(static_cast<int>(ytype::direction::up) <= side_mask, "sides dont fit in a packed vertex");
+	static_assert(tiles_fit(), "block textures dont fit in a packed vertex");
+};
+
+#endif
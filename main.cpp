@@ -29,7 +29,7 @@ class game_controller
 {
 private:
 	enum ykey {forward = 0, back, right, left, jump, crouch, yLAST};
-	enum text_id {xpos = 0, ypos, zpos, fps, tLAST};
+	enum text_id {xpos = 0, ypos, zpos, fps, uploads, meshes, loading, tLAST};
 
 public:
 	game_controller();
@@ -93,10 +93,12 @@ private:
 	int _chunks_amount;
 	
 	core::shader_program _game_object_shader;
+	core::shader_program _chunk_shader;
 
 	const font_data* _default_font;
 	
 	unsigned _shader_player_pos_id = -1;
+	unsigned _chunk_shader_player_pos_id = -1;
 	
 
 	character _main_character;
@@ -192,6 +194,11 @@ void game_controller::graphics_init()
 		_shaders_map["gameobject.vertex"],
 		core::shader());
 
+	_chunk_shader = core::shader_program(
+		_shaders_map["chunk.fragment"],
+		_shaders_map["chunk.vertex"],
+		core::shader());
+
 
 	_main_character = character();
 	_main_character.move_speed = 500;
@@ -199,9 +206,10 @@ void game_controller::graphics_init()
 	_main_character.floating = true;
 	_main_character.position = {0, 30, 0};
 
-	world_ctl = world_controller(main_window, &_main_character,
-		graphics_state{&_main_camera, &_game_object_shader,
-			&_textures_map.at("block_textures"), &_textures_map.at("transparent_blocks")});
+	const graphics_state graphics{&_main_camera, &_chunk_shader,
+		&_textures_map.at("block_textures"), &_textures_map.at("transparent_blocks")};
+
+	world_ctl = world_controller(main_window, &_main_character, graphics);
 
 	_main_physics.connect_object(&_main_character);
 	_main_raycaster = std::make_unique<physics::raycaster>(world_ctl.world_chunks);
@@ -212,6 +220,13 @@ void game_controller::graphics_init()
 	_game_object_shader.set_prop(_game_object_shader.add_num("render_distance"),
 								 world_ctl.render_dist()*chunk_size-chunk_size*2);
 
+	_chunk_shader_player_pos_id = _chunk_shader.add_vec3("player_pos");
+	_chunk_shader.set_prop(_chunk_shader.add_vec3("fog_color"), yvec3{sky_color.r, sky_color.g, sky_color.b});
+	_chunk_shader.set_prop(_chunk_shader.add_num("render_distance"),
+						   world_ctl.render_dist()*chunk_size-chunk_size*2);
+	//both atlases are cut into tiles of the same size
+	_chunk_shader.set_prop(_chunk_shader.add_num("tile_pixels"), graphics.opaque_atlas.block_width);
+
 
 	mousepos_update(_last_mouse_x, _last_mouse_y);
 
@@ -243,6 +258,24 @@ void game_controller::graphics_init()
 		yvec2{0, 0}},
 		_default_font, "undefined");
 
+	_texts_arr[text_id::uploads] = &_debug_panel->add_text(gui::object_info{
+		yvec3{0, 0.5, 0},
+		yvec2{0.2, 0.2},
+		yvec2{0, 0}},
+		_default_font, "undefined");
+
+	_texts_arr[text_id::meshes] = &_debug_panel->add_text(gui::object_info{
+		yvec3{0, 0.4, 0},
+		yvec2{0.2, 0.2},
+		yvec2{0, 0}},
+		_default_font, "undefined");
+
+	_texts_arr[text_id::loading] = &_debug_panel->add_text(gui::object_info{
+		yvec3{0, 0.3, 0},
+		yvec2{0.2, 0.2},
+		yvec2{0, 0}},
+		_default_font, "undefined");
+
 	update_status_texts();
 
 	/*
@@ -276,6 +309,18 @@ void game_controller::update_status_texts()
 
 	_texts_arr[text_id::fps]->object.set_text("fps: "+std::to_string(_display_fps));
 
+	const upload_queue::counters& upload_counters = world_ctl.upload_counters();
+	_texts_arr[text_id::uploads]->object.set_text("uploads: "+std::to_string(upload_counters.uploads)
+		+" ("+std::to_string(upload_counters.bytes/1024)+"kb), waiting: "+std::to_string(upload_counters.waiting));
+
+	const mesh_cache::counters cache_counters = world_ctl.mesh_cache_counters();
+	_texts_arr[text_id::meshes]->object.set_text("mesh cache: "+std::to_string(cache_counters.hits)
+		+" hits, "+std::to_string(cache_counters.misses)+" misses");
+
+	const world_controller::load_timings& load_timings = world_ctl.timings();
+	_texts_arr[text_id::loading]->object.set_text("loaded: playable "+std::to_string(static_cast<int>(load_timings.playable))
+		+"ms, visible "+std::to_string(static_cast<int>(load_timings.visible))+"ms");
+
 	_debug_panel->update();
 }
 
@@ -439,6 +484,7 @@ void game_controller::update_func()
 	}
 	
 	_game_object_shader.set_prop(_shader_player_pos_id, yvec3{_main_character.position.x, _main_character.position.y, _main_character.position.z});
+	_chunk_shader.set_prop(_chunk_shader_player_pos_id, yvec3{_main_character.position.x, _main_character.position.y, _main_character.position.z});
 	
 	
 	update_status_texts();
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <bit>
 #include <cassert>
 
 #include "physics.h"
@@ -26,8 +27,8 @@ world::world(const cmap::controller& world_chunks)
 
 bool world::collision_point(const vec3d<float> pos) const noexcept
 {
-	return _world_chunks.at(world_chunk::active_chunk(pos)).chunk.block
-		(world_chunk::closest_bound_block(pos)).block_type!=block::air;
+	return _world_chunks.at(world_chunk::active_chunk(pos)).chunk.solid
+		(world_chunk::closest_bound_block(pos));
 }
 
 raycast_result raycaster::raycast(const vec3d<float> start_pos, const vec3d<float> end_pos) const
@@ -48,12 +49,7 @@ raycast_result raycaster::raycast(const vec3d<float> start_pos, const vec3d<floa
 	vec3d<int> c_chunk_pos = world_chunk::active_chunk(start_pos);
 	vec3d<int> c_block_pos = world_chunk::closest_bound_block(start_pos);
 
-	vec3d<bool> move_side{false, false, false};
-
-
-	const vec3d<float> fractional_pos{fraction(start_pos)};
-
-	vec3d<float> position_change = distance_change(start_pos, direction, fractional_pos);
+	ray_state ray = create_ray(start_pos, direction);
 
 	while(true)
 	{
@@ -62,20 +58,33 @@ raycast_result raycaster::raycast(const vec3d<float> start_pos, const vec3d<floa
 			return raycast_result{ytype::direction::none, {0, 0, 0}, {0, 0, 0}};
 
 		const world_chunk& c_chunk = c_iter->chunk;
+
+		const bool chunk_air = c_chunk.empty() || c_chunk.check_empty();
+
 		while(true)
 		{
-			if(!c_chunk.empty() && c_chunk.block(c_block_pos).block_type!=block::air)
-				return raycast_result{(move_side.x?
-					(direction.x<0? ytype::direction::left : ytype::direction::right)
-					:(move_side.y?(direction.y<0? ytype::direction::down : ytype::direction::up)
-					:(direction.z<0? ytype::direction::back : ytype::direction::forward))),
-					c_chunk_pos, c_block_pos};
+			if(!chunk_air && c_chunk.solid(c_block_pos))
+				return raycast_result{hit_side(ray, direction), c_chunk_pos, c_block_pos};
+
+			vec3d<int> low, high;
+			empty_box(c_chunk, chunk_air, ray, c_block_pos, low, high);
+
+			if(low!=high)
+			{
+				const int skipped = skip_box(ray, c_block_pos, low, high);
+
+				//ran out before leaving the empty blocks
+				if(skipped>length)
+					return raycast_result{ytype::direction::none, {0, 0, 0}, {0, 0, 0}};
+
+				length -= skipped;
+			}
 
 			if(length==0)
 				return raycast_result{ytype::direction::none, {0, 0, 0}, {0, 0, 0}};
 
 			--length;
-			if(next_block({position_change, move_side, c_chunk_pos, c_block_pos}, direction))
+			if(next_block(ray, c_chunk_pos, c_block_pos))
 				break;
 		}
 	}
@@ -99,135 +108,151 @@ int raycaster::raycast_distance(const vec3d<float> ray_start, const raycast_resu
 	return chunk_offset.magnitude();
 }
 
-bool raycaster::next_block(ray_info ray, const vec3d<float> direction) noexcept
+raycaster::ray_state raycaster::create_ray(const vec3d<float> start_pos, const vec3d<float> direction) noexcept
 {
-	const vec3d<float> normalized_direction = direction.normalize();
-	const vec3d<float> direction_abs = normalized_direction.abs();
-
-	const vec3d<float> wall_dist{
-		(direction.x==0 ? INFINITY : (1-ray.change.x)/direction_abs.x),
-		(direction.y==0 ? INFINITY : (1-ray.change.y)/direction_abs.y),
-		(direction.z==0 ? INFINITY : (1-ray.change.z)/direction_abs.z)};
+	ray_state ray;
 
+	const std::array<float, 3> start{start_pos.x, start_pos.y, start_pos.z};
+	const std::array<float, 3> c_direction{direction.x, direction.y, direction.z};
 
-	if(wall_dist.x <= wall_dist.y && wall_dist.x <= wall_dist.z)
-	{
-		return next_block_calcs<true, false, false>(ray, direction, normalized_direction, wall_dist);
-	} else if(wall_dist.y <= wall_dist.x && wall_dist.y <= wall_dist.z)
+	for(int axis = 0; axis < 3; ++axis)
 	{
-		return next_block_calcs<false, true, false>(ray, direction, normalized_direction, wall_dist);
-	} else
-	{
-		return next_block_calcs<false, false, true>(ray, direction, normalized_direction, wall_dist);
+		if(c_direction[axis]==0)
+		{
+			ray.step[axis] = 0;
+			ray.next_wall[axis] = INFINITY;
+			ray.wall_distance[axis] = INFINITY;
+			continue;
+		}
+
+		//rounded the same way closest_bound_block picks the starting block
+		const float block_start = start[axis]<0 ? static_cast<int>(start[axis]-1) : static_cast<int>(start[axis]);
+
+		ray.step[axis] = c_direction[axis]<0 ? -1 : 1;
+		ray.wall_distance[axis] = 1/std::abs(c_direction[axis]);
+		ray.next_wall[axis] = (c_direction[axis]<0 ? start[axis]-block_start : block_start+1-start[axis])*ray.wall_distance[axis];
 	}
+
+	return ray;
 }
 
-template<bool x_b, bool y_b, bool z_b>
-bool raycaster::next_block_calcs(ray_info ray, const vec3d<float> direction, const vec3d<float> normalized_direction, const vec3d<float> wall_dist) noexcept
+bool raycaster::next_block(ray_state& ray, vec3d<int>& chunk, vec3d<int>& block) noexcept
 {
-	ray.side = {x_b, y_b, z_b};
+	const std::array<float, 3>& next = ray.next_wall;
 
-	const float c_dist = x_b ? wall_dist.x : y_b ? wall_dist.y : wall_dist.z;
+	const int axis = (next[0]<=next[1] && next[0]<=next[2]) ? 0 : (next[1]<=next[2] ? 1 : 2);
 
-	vec3d<float>& change = ray.change;
+	ray.side = axis;
+	ray.next_wall[axis] += ray.wall_distance[axis];
 
-	if(x_b)
-		change.x = 0;
-	else
+	int& c_block = component(block, axis);
+	c_block += ray.step[axis];
+
+	if(c_block<0 || c_block>=chunk_size)
 	{
-		change.x += std::abs(c_dist*normalized_direction.x);
-		change.x = change.x>1 ? 1 : change.x;
+		c_block -= ray.step[axis]*chunk_size;
+		component(chunk, axis) += ray.step[axis];
+
+		return true;
 	}
 
-	if(y_b)
-		change.y = 0;
-	else
+	return false;
+}
+
+int raycaster::skip_box(ray_state& ray, vec3d<int>& block, const vec3d<int> low, const vec3d<int> high) noexcept
+{
+	//walls left inside of the box on each axis, the ray leaves through the one it reaches first after them
+	std::array<int, 3> walls{0, 0, 0};
+	float exit_distance = INFINITY;
+
+	for(int axis = 0; axis < 3; ++axis)
 	{
-		change.y += std::abs(c_dist*normalized_direction.y);
-		change.y = change.y>1 ? 1 : change.y;
+		if(ray.step[axis]==0)
+			continue;
+
+		walls[axis] = ray.step[axis]>0 ? component(high, axis)-component(block, axis) : component(block, axis)-component(low, axis);
+		exit_distance = std::min(exit_distance, ray.next_wall[axis]+walls[axis]*ray.wall_distance[axis]);
 	}
 
-	if(z_b)
-		change.z = 0;
-	else
+	int moved = 0;
+	for(int axis = 0; axis < 3; ++axis)
 	{
-		change.z += std::abs(c_dist*normalized_direction.z);
-		change.z = change.z>1 ? 1 : change.z;
-	}
+		if(ray.step[axis]==0)
+			continue;
 
-	int& c_block = x_b ? ray.block.x : y_b ? ray.block.y : ray.block.z;
-	int& c_chunk = x_b ? ray.chunk.x : y_b ? ray.chunk.y : ray.chunk.z;
+		const float crossed_walls = std::ceil((exit_distance-ray.next_wall[axis])/ray.wall_distance[axis]);
+		const int crossed = std::clamp(static_cast<int>(crossed_walls), 0, walls[axis]);
 
-	const bool c_direction = x_b ? direction.x<0 : y_b ? direction.y<0 : direction.z<0;
+		component(block, axis) += crossed*ray.step[axis];
+		ray.next_wall[axis] += crossed*ray.wall_distance[axis];
 
-	return calculate_next(c_direction, c_chunk, c_block);
+		moved += crossed;
+	}
+
+	return moved;
 }
 
-bool raycaster::calculate_next(const bool positive, int& chunk, int& block) noexcept
+void raycaster::empty_box(const world_chunk& chunk, const bool chunk_air, const ray_state& ray, const vec3d<int> block,
+	vec3d<int>& low, vec3d<int>& high) noexcept
 {
-	if(positive)
+	if(chunk_air)
 	{
-		--block;
-		if(block==-1)
-		{
-			block = chunk_size-1;
-			--chunk;
-			return true;
-		}
-	} else
+		low = {0, 0, 0};
+		high = {chunk_size-1, chunk_size-1, chunk_size-1};
+		return;
+	}
+
+	const vec3d<int> brick = block/world_chunk::brick_size;
+	if(chunk.brick_empty(brick))
 	{
-		++block;
-		if(block==chunk_size)
-		{
-			block = 0;
-			++chunk;
-			return true;
-		}
+		low = brick*world_chunk::brick_size;
+		high = low+vec3d<int>{world_chunk::brick_size-1, world_chunk::brick_size-1, world_chunk::brick_size-1};
+		return;
 	}
 
-	return false;
-}
+	low = block;
+	high = block;
 
-vec3d<float> raycaster::distance_change(const vec3d<float> start_pos, const vec3d<float> direction, const vec3d<float> fraction) noexcept
-{
-	vec3d<float> change;
+	if(ray.step[1]==0)
+		return;
 
-	if(start_pos.x<0)
-	{
-		change.x = direction.x<0 ? fraction.x : 1-fraction.x;
-	} else
-	{
-		change.x = direction.x<0 ? 1-fraction.x : fraction.x;
-	}
+	const std::uint64_t column = chunk.solid_column(block.x, block.z);
 
-	if(start_pos.y<0)
+	//up to the block before the next solid one in the rays direction, or the end of the column
+	if(ray.step[1]>0)
 	{
-		change.y = direction.y<0 ? fraction.y : 1-fraction.y;
+		const std::uint64_t above = column>>(block.y+1);
+		high.y = above==0 ? chunk_size-1 : block.y+std::countr_zero(above);
 	} else
 	{
-		change.y = direction.y<0 ? 1-fraction.y : fraction.y;
+		const std::uint64_t below = column & ((std::uint64_t(1)<<block.y)-1);
+		low.y = std::bit_width(below);
 	}
+}
 
-	if(start_pos.z<0)
-	{
-		change.z = direction.z<0 ? fraction.z : 1-fraction.z;
-	} else
+ytype::direction raycaster::hit_side(const ray_state& ray, const vec3d<float> direction) noexcept
+{
+	switch(ray.side)
 	{
-		change.z = direction.z<0 ? 1-fraction.z : fraction.z;
-	}
+		default:
+			return direction.z<0 ? ytype::direction::back : ytype::direction::forward;
+
+		case 0:
+			return direction.x<0 ? ytype::direction::left : ytype::direction::right;
 
-	return change;
+		case 1:
+			return direction.y<0 ? ytype::direction::down : ytype::direction::up;
+	}
 }
 
-vec3d<float> raycaster::fraction(const vec3d<float> val) noexcept
+int& raycaster::component(vec3d<int>& vec, const int axis) noexcept
 {
-	return vec3d<float>{fraction(val.x), fraction(val.y), fraction(val.z)};
+	return axis==0 ? vec.x : (axis==1 ? vec.y : vec.z);
 }
 
-float raycaster::fraction(const float val) noexcept
+int raycaster::component(const vec3d<int>& vec, const int axis) noexcept
 {
-	float temp;
-	return std::abs(std::modf(val, &temp));
+	return axis==0 ? vec.x : (axis==1 ? vec.y : vec.z);
 }
 
 object::object()
@@ -52,24 +52,35 @@ namespace physics
 		int raycast_distance(const vec3d<float> ray_start, const raycast_result raycast) const;
 
 	private:
-		struct ray_info
+		//distances are in lengths of the direction vector, axes go x y z
+		struct ray_state
 		{
-			vec3d<float>& change;
-			vec3d<bool>& side;
-			vec3d<int>& chunk;
-			vec3d<int>& block;
+			std::array<int, 3> step;
+			//distance at which the next wall on each axis gets crossed
+			std::array<float, 3> next_wall;
+			//distance between two walls on each axis
+			std::array<float, 3> wall_distance;
+
+			//axis of the last crossed wall, -1 before the first one
+			int side = -1;
 		};
 
-		static bool next_block(ray_info ray, const vec3d<float> direction) noexcept;
+		static ray_state create_ray(const vec3d<float> start_pos, const vec3d<float> direction) noexcept;
 
-		template<bool x_b, bool y_b, bool z_b>
-		static bool next_block_calcs(ray_info ray, const vec3d<float> direction, const vec3d<float> normalized_direction, const vec3d<float> wall_dist) noexcept;
+		//true if the ray moved into the next chunk
+		static bool next_block(ray_state& ray, vec3d<int>& chunk, vec3d<int>& block) noexcept;
+		//moves the ray to the last block it goes through inside of the box, returns how many blocks it moved
+		static int skip_box(ray_state& ray, vec3d<int>& block, const vec3d<int> low, const vec3d<int> high) noexcept;
 
-		static bool calculate_next(const bool positive, int& chunk, int& block) noexcept;
+		//blocks the ray can cross in one go without checking them, only the block itself if there are none
+		//the whole chunk if its air, the brick if it has no solid blocks, otherwise the empty run of the column
+		static void empty_box(const world_chunk& chunk, const bool chunk_air, const ray_state& ray, const vec3d<int> block,
+			vec3d<int>& low, vec3d<int>& high) noexcept;
 
-		static vec3d<float> distance_change(const vec3d<float> start_pos, const vec3d<float> direction, const vec3d<float> fraction) noexcept;
-		static vec3d<float> fraction(const vec3d<float> val) noexcept;
-		static float fraction(const float val) noexcept;
+		static ytype::direction hit_side(const ray_state& ray, const vec3d<float> direction) noexcept;
+
+		static int& component(vec3d<int>& vec, const int axis) noexcept;
+		static int component(const vec3d<int>& vec, const int axis) noexcept;
 	};
 
 	class world_observer
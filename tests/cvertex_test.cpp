@@ -0,0 +1,56 @@
+#include <iostream>
+
+#include "cvertex.h"
+
+using namespace world_types;
+
+//packs and unpacks every combination of field values at the edges of their bit ranges
+
+int main()
+{
+	const int positions[] = {0, 1, chunk_size-1, chunk_size, chunk_vertex::position_mask};
+	const int tiles[] = {0, 1, chunk_vertex::tile_mask};
+
+	const ytype::direction sides[] = {ytype::direction::none, ytype::direction::left, ytype::direction::right,
+		ytype::direction::forward, ytype::direction::back, ytype::direction::down, ytype::direction::up};
+
+	//everything above the last field has to stay empty
+	const std::uint32_t used_bits = (std::uint64_t(1)<<(chunk_vertex::tile_shift+chunk_vertex::tile_bits*2))-1;
+
+	int checked = 0;
+	int failed = 0;
+
+	for(const int x : positions)
+	{
+		for(const int y : positions)
+		{
+			for(const int z : positions)
+			{
+				for(const auto side : sides)
+				{
+					for(const int tile_x : tiles)
+					{
+						for(const int tile_y : tiles)
+						{
+							const chunk_vertex::vertex c_vertex{{x, y, z}, side, tex_pos{tile_x, tile_y}};
+							const std::uint32_t packed = chunk_vertex::pack(c_vertex);
+
+							++checked;
+
+							if(chunk_vertex::unpack(packed)==c_vertex && (packed & ~used_bits)==0)
+								continue;
+
+							++failed;
+							std::cout << "round trip failed for " << x << " " << y << " " << z
+								<< " side " << static_cast<int>(side) << " tile " << tile_x << " " << tile_y << std::endl;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	std::cout << checked << " vertices checked, " << failed << " failed" << std::endl;
+
+	return failed==0 ? 0 : 1;
+}
@@ -68,3 +68,10 @@ int ytype::round_away(const float val) noexcept
 {
 	return val<0?static_cast<int>(std::floor(val)):static_cast<int>(std::ceil(val));
 }
+
+std::uint64_t ytype::hash_combine(const std::uint64_t seed, const std::uint64_t value) noexcept
+{
+	std::uint64_t hash = (seed^value)*0x9e3779b97f4a7c15;
+
+	return hash^(hash>>32);
+}
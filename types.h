@@ -2,6 +2,7 @@
 #define TYPES_H
 
 #include <cmath>
+#include <cstdint>
 #include <ostream>
 #include <tuple>
 
@@ -154,6 +155,9 @@ namespace ytype
 	vec3d<int> direction_add(const vec3d<int> add_vec, const ytype::direction direction, const int offset);
 
 	int round_away(const float val) noexcept;
+
+	//mixes a value into a running hash, not meant to be secure
+	std::uint64_t hash_combine(const std::uint64_t seed, const std::uint64_t value) noexcept;
 };
 
 #endif
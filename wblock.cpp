@@ -4,57 +4,23 @@
 using namespace ytype;
 using namespace world_types;
 
-void world_block::update()
+world_block::world_block()
+: world_block(block::air)
 {
 }
 
-loot world_block::destroy()
+world_block::world_block(const block type, const block_info info)
+: id(static_cast<std::uint16_t>(block_registry::variant(type, info.grassy)))
 {
-	block_type = block::air;
-
-	return loot{};
 }
 
-texture_face world_block::texture() const
+void world_block::update()
 {
-	switch(block_type)
-	{
-		case block::dirt:
-			return info.grassy ? texture_face{{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 1}, {0, 2}}
-			: texture_face{{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}};
-			
-		case block::stone:
-			return texture_face{{1, 0}, {1, 0}, {1, 0}, {1, 0}, {1, 0}, {1, 0}};
-			
-		case block::sand:
-			return texture_face{{2, 0}, {2, 0}, {2, 0}, {2, 0}, {2, 0}, {2, 0}};
-			
-		case block::log:
-			return texture_face{{3, 0}, {3, 0}, {3, 0}, {3, 0}, {3, 1}, {3, 1}};
-			
-		case block::cactus:
-			return texture_face{{5, 0}, {5, 0}, {5, 0}, {5, 0}, {5, 1}, {5, 1}};
-			
-		case block::lava:
-			return texture_face{{6, 0}, {6, 0}, {6, 0}, {6, 0}, {6, 0}, {6, 0}};
-		
-		case block::leaf:
-			return texture_face{{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}};
-
-		default:
-			return texture_face{};
-	}
 }
 
-bool world_block::transparent() const
+loot world_block::destroy()
 {
-	switch(block_type)
-	{
-		case block::leaf:
-		case block::air:
-			return true;
-		
-		default:
-			return false;
-	}
+	*this = world_block(block::air);
+
+	return loot{};
 }
@@ -1,21 +1,43 @@
 #ifndef WBLOCK_H
 #define WBLOCK_H
 
+#include <cstdint>
+
 #include "worldtypes.h"
+#include "wregistry.h"
 #include "types.h"
 #include "inventory.h"
 
 
+//flags in the low bits with the block type above them
+//that way the id itself is the index into the property registry
 struct world_block
 {
-	int block_type;	
-	world_types::block_info info; 
+	static constexpr int flag_bits = 1;
+
+	static constexpr std::uint16_t grassy_flag = 1;
+
+	world_block();
+	world_block(const world_types::block type, const world_types::block_info info = {});
 
 	void update();
 	loot destroy();
 	
-	world_types::texture_face texture() const;
-	bool transparent() const;
+	world_types::block type() const noexcept {return static_cast<world_types::block>(id >> flag_bits);};
+	world_types::block_info info() const noexcept {return world_types::block_info{(id & grassy_flag)!=0};};
+
+	const block_registry::block_properties& properties() const noexcept
+	{
+		return block_registry::properties[id];
+	}
+
+	const world_types::texture_face& texture() const noexcept {return properties().texture;};
+	bool transparent() const noexcept {return properties().transparent;};
+	bool solid() const noexcept {return properties().solid;};
+
+	bool operator==(const world_block&) const = default;
+
+	std::uint16_t id;
 };
 
 namespace world_types
@@ -16,10 +16,12 @@ world_controller::world_controller()
 world_controller::world_controller(const GLFWwindow* main_window,
 	const character* main_character, const graphics_state graphics)
 : _main_window(main_window),
-_main_character(main_character), _main_camera(graphics.camera), _empty(false)
+_main_character(main_character), _main_camera(graphics.camera),
+_load_start(std::chrono::steady_clock::now()), _empty(false)
 {
-	_world_gen = std::make_unique<world_generator>(graphics);
-	world_chunks = cmap::controller(_world_gen.get(), _chunk_radius, main_character->active_chunk());
+	_world_gen = std::make_unique<world_generator>();
+	world_chunks = cmap::controller(_world_gen.get(), graphics,
+		_chunk_radius, _chunk_vertical_radius, main_character->active_chunk());
 
 	full_update();
 }
@@ -28,43 +30,46 @@ _main_character(main_character), _main_camera(graphics.camera), _empty(false)
 void world_controller::full_update()
 {
 	world_chunks.update();
+	world_chunks.update_view(_main_character->direction);
 	world_chunks.update_center(_main_character->active_chunk());
 }
 
 void world_controller::draw_update()
 {
-	std::multimap<float, std::reference_wrapper<model_chunk>> distance_models;
+	//edits from the last frame
+	world_chunks.update_dirty();
+	world_chunks.update_meshes();
+
+	update_timings();
+
+	const vec3d<int> c_pos = _main_character->active_chunk();
 
+	//only changed meshes get new buffers, nearest first
 	for(auto& f_chunk : world_chunks)
 	{
-		if(f_chunk.chunk.empty())
+		if(f_chunk.chunk.empty() || f_chunk.chunk.check_empty())
 			continue;
 
-		f_chunk.model.draw_opaque();
-	
-		const vec3d<int> chunk_pos = f_chunk.chunk.position();
-		const vec3d<int> c_pos = _main_character->active_chunk();
-		const vec3d<int> c_rel_pos = chunk_pos-c_pos;
+		f_chunk.model.queue_uploads(_uploads, (f_chunk.chunk.position()-c_pos).magnitude());
+	}
 
-		const float chunk_distance = std::pow(c_rel_pos.x, 2)
-			+ std::pow(c_rel_pos.y, 2)
-			+ std::pow(c_rel_pos.z, 2);
-		
-		const int render_dist_squared = _render_dist*_render_dist;
+	_uploads.upload();
 
-		//check if chunk is too far away to render
-		if(chunk_distance > render_dist_squared)
+	std::multimap<float, std::reference_wrapper<model_chunk>> distance_models;
+
+	for(auto& f_chunk : world_chunks)
+	{
+		if(f_chunk.chunk.empty() || f_chunk.chunk.check_empty())
 			continue;
 
-		//check if the chunk is in the camera frustum
-		const vec3d<float> check_pos_f =
-			(chunk_pos).cast<float>()*chunk_size
-			+vec3d<float>{chunk_size/2, chunk_size/2, chunk_size/2};
+		f_chunk.model.draw_opaque(_main_character->position);
+	
+		const vec3d<int> chunk_pos = f_chunk.chunk.position();
 
-		if(!_main_camera->cube_in_frustum({check_pos_f.x, check_pos_f.y, check_pos_f.z}, chunk_size))
+		if(!chunk_visible(chunk_pos, c_pos))
 			continue;
 		
-		const vec3d<float> c_fpos = c_rel_pos.cast<float>();
+		const vec3d<float> c_fpos = (chunk_pos-c_pos).cast<float>();
 		const float direction_distance = _main_camera->distance({c_fpos.x, c_fpos.y, c_fpos.z});
 		distance_models.insert({direction_distance, f_chunk.model});
 	}
@@ -76,6 +81,80 @@ void world_controller::draw_update()
 	}
 }
 
+bool world_controller::chunk_visible(const vec3d<int> chunk_pos, const vec3d<int> center) const
+{
+	const vec3d<int> c_rel_pos = chunk_pos-center;
+
+	const float chunk_distance = std::pow(c_rel_pos.x, 2)
+		+ std::pow(c_rel_pos.y, 2)
+		+ std::pow(c_rel_pos.z, 2);
+	
+	const int render_dist_squared = _render_dist*_render_dist;
+
+	//check if chunk is too far away to render
+	if(chunk_distance > render_dist_squared)
+		return false;
+
+	//check if the chunk is in the camera frustum
+	const vec3d<float> check_pos_f =
+		(chunk_pos).cast<float>()*chunk_size
+		+vec3d<float>{chunk_size/2, chunk_size/2, chunk_size/2};
+
+	return _main_camera->cube_in_frustum({check_pos_f.x, check_pos_f.y, check_pos_f.z}, chunk_size);
+}
+
+void world_controller::update_timings() noexcept
+{
+	if(_load_timings.visible!=0)
+		return;
+
+	const float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now()-_load_start).count();
+	const vec3d<int> c_pos = _main_character->active_chunk();
+
+	bool playable = true;
+	bool visible = true;
+
+	for(int x = -_render_dist; x <= _render_dist; ++x)
+	{
+		for(int y = -_render_dist; y <= _render_dist; ++y)
+		{
+			for(int z = -_render_dist; z <= _render_dist; ++z)
+			{
+				const vec3d<int> check_pos = c_pos+vec3d<int>{x, y, z};
+				if(!world_chunks.in_bounds(check_pos) || world_chunks.contains(check_pos))
+					continue;
+
+				if(std::abs(x)<=1 && std::abs(y)<=1 && std::abs(z)<=1)
+					playable = false;
+
+				if(chunk_visible(check_pos, c_pos))
+					visible = false;
+			}
+		}
+	}
+
+	if(_load_timings.playable==0 && playable)
+		_load_timings.playable = elapsed;
+
+	if(_load_timings.playable!=0 && visible)
+		_load_timings.visible = elapsed;
+}
+
+const world_controller::load_timings& world_controller::timings() const noexcept
+{
+	return _load_timings;
+}
+
+const upload_queue::counters& world_controller::upload_counters() const noexcept
+{
+	return _uploads.frame_counters();
+}
+
+mesh_cache::counters world_controller::mesh_cache_counters() const noexcept
+{
+	return world_chunks.mesh_cache_counters();
+}
+
 int world_controller::render_dist()
 {
 	return _render_dist;
@@ -4,6 +4,7 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <chrono>
 
 #include <glcyan.h>
 #include <ythreads.h>
@@ -19,6 +20,15 @@
 class world_controller
 {
 public:
+	//milliseconds from the world starting to load, 0 until reached
+	struct load_timings
+	{
+		//the chunk the character is in and its neighbours are loaded
+		float playable = 0;
+		//every chunk in view is loaded
+		float visible = 0;
+	};
+
 	world_controller();
 	world_controller(const GLFWwindow* main_window,
 	const character* main_character, const graphics_state graphics);
@@ -26,6 +36,10 @@ public:
 	void full_update();
 	
 	void draw_update();
+
+	const upload_queue::counters& upload_counters() const noexcept;
+	mesh_cache::counters mesh_cache_counters() const noexcept;
+	const load_timings& timings() const noexcept;
 	
 	
 	int render_dist();
@@ -36,6 +50,11 @@ public:
 private:
 	float chunk_outside(const vec3d<int> pos) const;
 
+	//in render distance and in the camera frustum
+	bool chunk_visible(const vec3d<int> chunk_pos, const vec3d<int> center) const;
+
+	void update_timings() noexcept;
+
 	void init_chunks();
 	
 	const GLFWwindow* _main_window = nullptr;
@@ -47,9 +66,17 @@ private:
 	std::vector<world_chunk> _processing_chunks;
 	
 	std::map<vec3d<int>, world_types::wall_states> _queued_blocks;
+
+	//at most this many bytes of chunk meshes get uploaded per frame
+	upload_queue _uploads{512*1024};
 	
 	int _chunk_radius = 6;
+	//terrain only spans a few chunks vertically, everything above is air and everything below stone
+	int _chunk_vertical_radius = 2;
 	int _render_dist = 5;
+
+	std::chrono::steady_clock::time_point _load_start;
+	load_timings _load_timings;
 	
 	bool _empty = true;
 };
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <random>
 #include <algorithm>
+#include <bit>
+#include <ctime>
 
 #include "wgen.h"
 #include "chunk.h"
@@ -9,9 +11,8 @@
 
 using namespace world_types;
 
-world_generator::world_generator(const graphics_state graphics)
-: _graphics(graphics),
-_seed(time(NULL))
+world_generator::world_generator()
+: _seed(time(NULL))
 {
 }
 
@@ -65,22 +66,15 @@ world_generator::generate_climate(const vec3d<int> pos, const float temperature_
 	return noise_arr;
 }
 
-full_chunk world_generator::full_chunk_gen(const vec3d<int> position) noexcept
+void world_generator::chunk_gen(world_chunk& chunk, const vec3d<int> position)
 {
-	return full_chunk(chunk_gen(position), _graphics);
-}
-
-world_chunk world_generator::chunk_gen(const vec3d<int> position)
-{
-	assert(_graphics.camera!=nullptr && _graphics.shader!=nullptr);
-
-	world_chunk chunk(position);
+	chunk.reset(position);
 
 	const float gen_height = 2.25f;
 	const float gen_depth = 0;
 
 	if(position.y>gen_height)
-		return chunk;
+		return;
 	
 	chunk.set_empty(false);
 	
@@ -88,11 +82,11 @@ world_chunk world_generator::chunk_gen(const vec3d<int> position)
 	
 	if(!overground)
 	{
-		chunk.blocks.fill(world_block{block::stone});
+		chunk.fill(world_block{block::stone});
 		
 		chunk.update_states();
 		
-		return chunk;
+		return;
 	}
 	
 	std::array<float, chunk_size*chunk_size> small_noise_arr = generate_noise(position, 1.05f, 0.25f);
@@ -102,13 +96,12 @@ world_chunk world_generator::chunk_gen(const vec3d<int> position)
 	std::array<climate_point, chunk_size*chunk_size> climate_arr = generate_climate(position, 0.0136f, 0.0073f);
 	
 	
-	int block_index = 0;
-	
+	//chunks start out filled with air
 	for(int x = 0; x < chunk_size; ++x)
 	{
 		for(int y = 0; y < chunk_size; ++y)
 		{
-			for(int z = 0; z < chunk_size; ++z, ++block_index)
+			for(int z = 0; z < chunk_size; ++z)
 			{
 				const int maps_index = x*chunk_size+z;
 				const float c_temperature = climate_arr[maps_index].temperature;
@@ -122,13 +115,13 @@ world_chunk world_generator::chunk_gen(const vec3d<int> position)
 					{
 						case biome::desert:
 						{
-							chunk.blocks[block_index] = world_block{block::sand};
+							chunk.set_block(world_block{block::sand}, {x, y, z});
 							break;
 						}
 						
 						case biome::hell:
 						{
-							chunk.blocks[block_index] = world_block{block::lava};
+							chunk.set_block(world_block{block::lava}, {x, y, z});
 							break;
 						}
 						
@@ -136,13 +129,10 @@ world_chunk world_generator::chunk_gen(const vec3d<int> position)
 						case biome::forest:
 						{
 							bool c_grass = (position.y*chunk_size+y+1)>=c_noise;
-							chunk.blocks[block_index] = world_block{block::dirt, block_info{c_grass}};
+							chunk.set_block(world_block{block::dirt, block_info{c_grass}}, {x, y, z});
 							break;
 						}
 					}
-				} else
-				{
-					chunk.blocks[block_index] = world_block{block::air};
 				}
 			}
 		}
@@ -151,8 +141,6 @@ world_chunk world_generator::chunk_gen(const vec3d<int> position)
 	gen_plants(chunk, climate_arr);
 	
 	chunk.update_states();
-	
-	return chunk;
 }
 
 biome world_generator::get_biome(float temperature, float humidity) const noexcept
@@ -172,15 +160,15 @@ biome world_generator::get_biome(float temperature, float humidity) const noexce
 vec3d<int>
 world_generator::get_ground(const world_chunk& check_chunk, const int x, const int z) const noexcept
 {
-	for(int i = 0; i < chunk_size; ++i)
-	{
-		if(check_chunk.block({x, i, z}).transparent())
-		{
-			return vec3d<int>{x, i, z};
-		}
-	}
+	const std::uint32_t opaque = check_chunk.solid_column(x, z) & ~check_chunk.transparent_column(x, z);
+
+	//lowest block that isnt opaque
+	const int ground = std::countr_one(opaque);
+
+	if(ground>=chunk_size)
+		return vec3d<int>{x, 0, z};
 
-	return vec3d<int>{x, 0, z};
+	return vec3d<int>{x, ground, z};
 }
 
 void world_generator::gen_plants(world_chunk& gen_chunk, const std::array<climate_point, chunk_size*chunk_size>& climate_arr) noexcept
@@ -274,7 +262,7 @@ void world_generator::shared_place(world_chunk& chunk, const vec3d<int> position
 			world_chunk::closest_bound_block(position), block);
 	} else
 	{
-		chunk.block(position) = block;
+		chunk.set_block(block, position);
 	}
 }
 
@@ -292,3 +280,13 @@ void world_generator::place_in_chunk(const vec3d<int> chunk_pos, const std::vect
 	std::vector<block_pos>& c_blocks = _blocks_map[chunk_pos];
 	c_blocks.insert(c_blocks.end(), blocks.begin(), blocks.end());
 }
+
+std::map<vec3d<int>, std::vector<world_generator::block_pos>> world_generator::take_placed() noexcept
+{
+	std::lock_guard<std::mutex> lock_b(_mtx_block_place);
+
+	std::map<vec3d<int>, std::vector<block_pos>> placed;
+	placed.swap(_blocks_map);
+
+	return placed;
+}
@@ -8,12 +8,12 @@
 #include "types.h"
 #include "worldtypes.h"
 #include "wblock.h"
-#include "cmodel.h"
+#include "chunk.h"
 
 
 class world_generator
 {
-protected:
+public:
 	struct block_pos
 	{
 		vec3d<int> pos;
@@ -22,15 +22,14 @@ protected:
 		block_pos(vec3d<int> pos, world_block block) : pos(pos), block(block) {};
 	};
 
-public:
 	typedef std::array<world_types::climate_point, world_types::chunk_size*world_types::chunk_size> climate_noise;
 
-	world_generator(const graphics_state graphics);
+	world_generator();
 	
 	void seed(unsigned seed);
 	
-	full_chunk full_chunk_gen(const vec3d<int> position) noexcept;
-	world_chunk chunk_gen(const vec3d<int> position);
+	//generates into an existing chunk so its storage can be reused
+	void chunk_gen(world_chunk& chunk, const vec3d<int> position);
 	world_types::biome get_biome(const float temperature, const float humidity) const noexcept;
 	void gen_plants(world_chunk& gen_chunk, const climate_noise& climate_arr) noexcept;
 	
@@ -39,6 +38,9 @@ public:
 	void place_in_chunk(const vec3d<int> chunk_pos, const vec3d<int> pos, const world_block block) noexcept;
 	void place_in_chunk(const vec3d<int> chunk_pos, const std::vector<block_pos>& blocks) noexcept;
 
+	//blocks of structures that reached past the chunk they were generated in, by the chunk they belong to
+	std::map<vec3d<int>, std::vector<block_pos>> take_placed() noexcept;
+
 protected:
 	std::array<float, world_types::chunk_size*world_types::chunk_size>
 	generate_noise(const vec3d<int> pos, const float noise_scale, const float noise_strength) const noexcept;
@@ -54,8 +56,6 @@ protected:
 
 	noise_generator _noise_gen;
 
-	graphics_state _graphics;
-
 	unsigned _seed = 1;
 	
 	friend class world_controller;
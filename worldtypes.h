@@ -11,6 +11,8 @@ namespace world_types
 	{
 		int x;
 		int y;
+
+		bool operator==(const tex_pos&) const = default;
 	};
 	
 	struct climate_point
@@ -35,7 +37,8 @@ namespace world_types
 		log,
 		leaf,
 		cactus,
-		lava
+		lava,
+		bLAST
 	};
 	
 	struct texture_face
@@ -46,6 +49,31 @@ namespace world_types
 		tex_pos left;
 		tex_pos up;
 		tex_pos down;
+
+		tex_pos side(const ytype::direction side) const
+		{
+			switch(side)
+			{
+				case ytype::direction::back:
+					return back;
+
+				case ytype::direction::right:
+					return right;
+
+				case ytype::direction::left:
+					return left;
+
+				case ytype::direction::up:
+					return up;
+
+				case ytype::direction::down:
+					return down;
+
+				default:
+				case ytype::direction::forward:
+					return forward;
+			}
+		};
 	};
 	
 	struct wall_states
@@ -58,6 +86,30 @@ namespace world_types
 		bool back = true;
 		
 		bool walls_or() {return right || left || up || down || forward || back;};
+		bool side(const ytype::direction side) const
+		{
+			switch(side)
+			{
+				case ytype::direction::left:
+					return left;
+
+				case ytype::direction::up:
+					return up;
+
+				case ytype::direction::down:
+					return down;
+
+				case ytype::direction::forward:
+					return forward;
+
+				case ytype::direction::back:
+					return back;
+
+				default:
+				case ytype::direction::right:
+					return right;
+			}
+		};
 		void add_walls(wall_states walls)
 		{
 			right = right||walls.right;
@@ -72,6 +124,8 @@ namespace world_types
 	struct block_info
 	{
 		bool grassy;
+
+		bool operator==(const block_info&) const = default;
 	};
 };
 
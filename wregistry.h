@@ -0,0 +1,99 @@
+#ifndef WREGISTRY_H
+#define WREGISTRY_H
+
+#include <array>
+
+#include "worldtypes.h"
+
+
+namespace block_registry
+{
+	struct block_properties
+	{
+		world_types::texture_face texture;
+
+		bool transparent;
+		bool solid;
+	};
+
+	//every block type has a plain and a grassy variant
+	constexpr int variants_amount = world_types::block::bLAST*2;
+
+	//same as the id of a world_block, the grassy flag is the lowest bit
+	constexpr int variant(const world_types::block type, const bool grassy) noexcept
+	{
+		return type*2+(grassy ? 1 : 0);
+	}
+
+	constexpr world_types::texture_face block_texture(const world_types::block type, const bool grassy) noexcept
+	{
+		using namespace world_types;
+
+		switch(type)
+		{
+			case block::dirt:
+				return grassy ? texture_face{{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 1}, {0, 2}}
+				: texture_face{{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}};
+
+			case block::stone:
+				return texture_face{{1, 0}, {1, 0}, {1, 0}, {1, 0}, {1, 0}, {1, 0}};
+
+			case block::sand:
+				return texture_face{{2, 0}, {2, 0}, {2, 0}, {2, 0}, {2, 0}, {2, 0}};
+
+			case block::log:
+				return texture_face{{3, 0}, {3, 0}, {3, 0}, {3, 0}, {3, 1}, {3, 1}};
+
+			case block::cactus:
+				return texture_face{{5, 0}, {5, 0}, {5, 0}, {5, 0}, {5, 1}, {5, 1}};
+
+			case block::lava:
+				return texture_face{{6, 0}, {6, 0}, {6, 0}, {6, 0}, {6, 0}, {6, 0}};
+
+			case block::leaf:
+				return texture_face{{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}};
+
+			default:
+				return texture_face{};
+		}
+	}
+
+	constexpr bool block_transparent(const world_types::block type) noexcept
+	{
+		using namespace world_types;
+
+		switch(type)
+		{
+			case block::leaf:
+			case block::air:
+				return true;
+
+			default:
+				return false;
+		}
+	}
+
+	constexpr std::array<block_properties, variants_amount> create_properties() noexcept
+	{
+		std::array<block_properties, variants_amount> properties{};
+
+		for(int i = 0; i < world_types::block::bLAST; ++i)
+		{
+			const world_types::block type = static_cast<world_types::block>(i);
+
+			for(const bool grassy : {false, true})
+			{
+				properties[variant(type, grassy)] = block_properties{
+					block_texture(type, grassy),
+					block_transparent(type),
+					type!=world_types::block::air};
+			}
+		}
+
+		return properties;
+	}
+
+	inline constexpr std::array<block_properties, variants_amount> properties = create_properties();
+};
+
+#endif